@@ -18,6 +18,7 @@ HEADERS += \
 src/connectors/bus.h \
 src/connectors/busshared.h \
 src/connectors/connector.h \
+src/connectors/connectorindex.h \
 src/connectors/connectoritem.h \
 src/connectors/nonconnectoritem.h \
 src/connectors/connectorshared.h \
@@ -30,6 +31,7 @@ SOURCES += \
 src/connectors/bus.cpp \
 src/connectors/busshared.cpp \
 src/connectors/connector.cpp \
+src/connectors/connectorindex.cpp \
 src/connectors/connectoritem.cpp \
 src/connectors/nonconnectoritem.cpp \
 src/connectors/connectorshared.cpp \
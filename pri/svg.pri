@@ -17,7 +17,10 @@ HEADERS += src/svg/svgfilesplitter.h \
     src/svg/svgpathgrammar_p.h \
     src/svg/svgpathlexer.h \
     src/svg/svgpathrunner.h \
+    src/svg/svgpathscanner.h \
     src/svg/svg2gerber.h \
+    src/svg/drillorder.h \
+    src/svg/gerberpanel.h \
     src/svg/svgflattener.h \
     src/svg/gerbergenerator.h \
     src/svg/groundplanegenerator.h \
@@ -31,6 +34,9 @@ HEADERS += src/svg/svgfilesplitter.h \
     src/svg/gedaelementgrammar_p.h \
     src/svg/gedaelementlexer.h \
     src/svg/clipperhelpers.h \
+    src/svg/svglayercache.h \
+    src/svg/svgfixcache.h \
+    src/svg/svgfragmentcache.h \
     $$PWD/../src/svg/svgtext.h
 
 SOURCES += src/svg/svgfilesplitter.cpp \
@@ -38,7 +44,10 @@ SOURCES += src/svg/svgfilesplitter.cpp \
     src/svg/svgpathgrammar.cpp \
     src/svg/svgpathlexer.cpp \
     src/svg/svgpathrunner.cpp \
+    src/svg/svgpathscanner.cpp \
     src/svg/svg2gerber.cpp \
+    src/svg/drillorder.cpp \
+    src/svg/gerberpanel.cpp \
     src/svg/svgflattener.cpp \
     src/svg/gerbergenerator.cpp \
     src/svg/groundplanegenerator.cpp \
@@ -51,4 +60,7 @@ SOURCES += src/svg/svgfilesplitter.cpp \
     src/svg/gedaelementparser.cpp \
     src/svg/gedaelementgrammar.cpp \
     src/svg/gedaelementlexer.cpp \
+    src/svg/svglayercache.cpp \
+    src/svg/svgfixcache.cpp \
+    src/svg/svgfragmentcache.cpp \
     $$PWD/../src/svg/svgtext.cpp
@@ -36,6 +36,8 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QSettings>
 
 const QString Autorouter::MaxCyclesName("cmrouter/maxcycles");
+const QString Autorouter::NegotiatedName("CMRouter_Negotiated");	// also a sketch file attribute, so no "/"
+const QString Autorouter::WindowedSearchName("cmrouter/windowedsearch");		// no ui: set false to time the whole-board search
 
 Autorouter::Autorouter(PCBSketchWidget * sketchWidget) : m_sketchWidget(sketchWidget)
 {
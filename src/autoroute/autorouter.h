@@ -52,6 +52,8 @@ public:
 
 public:
 	static const QString MaxCyclesName;
+	static const QString NegotiatedName;
+	static const QString WindowedSearchName;
 
 
 protected:
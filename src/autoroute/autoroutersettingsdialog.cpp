@@ -47,6 +47,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../utils/textutils.h"
 #include "../utils/graphicsutils.h"
 #include "drc.h"
+#include "autorouter.h"
 
 
 const QString AutorouterSettingsDialog::AutorouteTraceWidth = "autorouteTraceWidth";
@@ -111,6 +112,15 @@ AutorouterSettingsDialog::AutorouterSettingsDialog(QHash<QString, QString> & set
 
 	windowLayout->addWidget(prodGroupBox);
 
+	m_negotiatedCheckBox = new QCheckBox(tr("Reroute only congested nets"), this);
+	m_negotiatedCheckBox->setToolTip(tr("Instead of rerouting every net in a new order each round, let nets share space at a rising cost and reroute only the nets that still overlap."));
+	QString negotiated = settings.value(Autorouter::NegotiatedName);
+	if (negotiated.isEmpty()) {
+		negotiated = QSettings().value(Autorouter::NegotiatedName, false).toString();
+	}
+	m_negotiatedCheckBox->setChecked(negotiated == "true");
+	windowLayout->addWidget(m_negotiatedCheckBox);
+
 	windowLayout->addSpacerItem(new QSpacerItem(1, 10, QSizePolicy::Preferred, QSizePolicy::Expanding));
 
 	windowLayout->addWidget(buttonBox);
@@ -377,6 +387,7 @@ QHash<QString, QString> AutorouterSettingsDialog::getSettings() {
 	settings.insert(Via::AutorouteViaHoleSize, m_holeSettings.holeDiameter);
 	settings.insert(Via::AutorouteViaRingThickness, m_holeSettings.ringThickness);
 	settings.insert(AutorouteTraceWidth, QString::number(m_traceWidth));
+	settings.insert(Autorouter::NegotiatedName, m_negotiatedCheckBox->isChecked() ? "true" : "false");
 
 	return settings;
 }
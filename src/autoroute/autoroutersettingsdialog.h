@@ -27,6 +27,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QRadioButton>
 #include <QGroupBox>
 #include <QDoubleSpinBox>
+#include <QCheckBox>
 
 #include "../items/via.h"
 
@@ -76,6 +77,7 @@ protected:
 	QDoubleSpinBox * m_keepoutSpinBox;
 	QRadioButton * m_inRadio;
 	QRadioButton * m_mmRadio;
+	QCheckBox * m_negotiatedCheckBox;
 
 public:
 	static const QString AutorouteTraceWidth;
@@ -74,6 +74,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QApplication>
 #include <QMessageBox>
 #include <QSettings>
+#include <QElapsedTimer>
 
 #include <qmath.h>
 #include <limits>
@@ -88,6 +89,13 @@ static QString CancelledMessage;
 
 static constexpr int DefaultMaxCycles = 100;
 
+static constexpr int MinSearchMargin = 16;       // grid cells around a net's endpoints for the first search window
+
+static constexpr GridValue NegotiatedPresentCost = 8;
+static constexpr GridValue MaxPresentCost = 16384;
+static constexpr quint16 NegotiatedHistoryCost = 4;
+static constexpr quint16 MaxHistoryCost = 4096;
+
 static constexpr GridValue GridBoardObstacle = std::numeric_limits<GridValue>::max();
 static constexpr GridValue GridPartObstacle = GridBoardObstacle - 1;
 static constexpr GridValue GridSource = GridBoardObstacle - 2;
@@ -239,6 +247,32 @@ inline double manhattanCost(const QPoint & p1, const QPoint & p2) {
 	return qMax(qAbs(p1.x() - p2.x()), qAbs(p1.y() - p2.y()));
 }
 
+void appendSquare(QList<int> & cells, const Grid * grid, int cx, int cy, int z, int half) {
+	if (z >= grid->z) return;
+
+	for (int y = qMax(0, cy - half); y <= qMin(grid->y - 1, cy + half); y++) {
+		for (int x = qMax(0, cx - half); x <= qMin(grid->x - 1, cx + half); x++) {
+			cells << (z * grid->x * grid->y) + (y * grid->x) + x;
+		}
+	}
+}
+
+bool betterScore(const Score & current, const Score & best) {
+	if (best.ordering.order.count() == 0) return true;
+	if (current.totalRoutedCount > best.totalRoutedCount) return true;
+	return current.totalRoutedCount == best.totalRoutedCount && current.totalViaCount < best.totalViaCount;
+}
+
+QRect seedBounds(std::priority_queue<GridPoint> pq) {
+	QRect bounds;
+	while (!pq.empty()) {
+		const GridPoint & gp = pq.top();
+		bounds |= QRect(gp.x, gp.y, 1, 1);
+		pq.pop();
+	}
+	return bounds;
+}
+
 inline int gridPointInt(Grid * grid, GridPoint & gp) {
 	return (gp.z * grid->x * grid->y) + (gp.y * grid->x) + gp.x;
 }
@@ -436,6 +470,14 @@ void Score::setOrdering(const NetOrdering & _ordering) {
 	//printOrder("new  ", ordering.order);
 }
 
+void Score::ripUp(int netIndex) {
+	totalRoutedCount -= routedCount.value(netIndex);
+	routedCount.insert(netIndex, 0);
+	totalViaCount -= viaCount.value(netIndex);
+	viaCount.insert(netIndex, 0);
+	traces.remove(netIndex);
+}
+
 ////////////////////////////////////////////////////////////////////
 
 static constexpr long IDs[] = { 1452191, 9781580, 9781600, 9781620, 9781640, 9781660, 9781680, 9781700 };
@@ -507,7 +549,13 @@ MazeRouter::MazeRouter(PCBSketchWidget * sketchWidget, QGraphicsItem * board, bo
     m_grid(nullptr),
     m_cleanupCount(0),
     m_netLabelIndex(-1),
-    m_commandCount(0)
+    m_commandCount(0),
+    m_negotiated(false),
+    m_negotiating(false),
+    m_windowedSearch(true),
+    m_searchNSecs(0),
+    m_searchWidenings(0),
+    m_presentCost(0)
 {
 
 	CancelledMessage = tr("Autorouter was cancelled.");
@@ -517,6 +565,13 @@ MazeRouter::MazeRouter(PCBSketchWidget * sketchWidget, QGraphicsItem * board, bo
 
 	m_bothSidesNow = sketchWidget->routeBothSides();
 	m_pcbType = sketchWidget->autorouteTypePCB();
+	// the sketch's own choice wins; older sketches did not save one
+	QString negotiated = sketchWidget->getAutorouterSettings().value(NegotiatedName);
+	if (negotiated.isEmpty()) {
+		negotiated = settings.value(NegotiatedName, false).toString();
+	}
+	m_negotiated = m_pcbType && negotiated == "true";
+	m_windowedSearch = settings.value(WindowedSearchName, true).toBool();
 	m_board = board;
 
 	if (m_board) {
@@ -758,32 +813,38 @@ void MazeRouter::start()
 	allOrderings << initialOrdering;
 	Score bestScore;
 	Score currentScore;
+	QElapsedTimer routeTimer;
+	routeTimer.start();
 	auto run = 0;
-	for (; run < m_maxCycles && run < allOrderings.count(); run++) {
-		QString msg= tr("best so far: %1 of %2 routed").arg(bestScore.totalRoutedCount).arg(totalToRoute);
-		if (m_pcbType) {
-			msg +=  tr(" with %n vias", "", bestScore.totalViaCount);
-		}
-		Q_EMIT setProgressMessage(msg);
-		Q_EMIT setCycleMessage(tr("round %1 of:").arg(run + 1));
-		Q_EMIT setProgressValue(run);
-		ProcessEventBlocker::processEvents();
-		currentScore.setOrdering(allOrderings.at(run));
-		currentScore.anyUnrouted = false;
-		routeNets(netList, false, currentScore, gridSize, allOrderings);
-		if (bestScore.ordering.order.count() == 0) {
-			bestScore = currentScore;
-		}
-		else {
-			if (currentScore.totalRoutedCount > bestScore.totalRoutedCount) {
-				bestScore = currentScore;
-			}
-			else if (currentScore.totalRoutedCount == bestScore.totalRoutedCount && currentScore.totalViaCount < bestScore.totalViaCount) {
+	if (m_negotiated) {
+		run = routeNegotiated(netList, bestScore, gridSize, totalToRoute, allOrderings);
+	}
+	else {
+		for (; run < m_maxCycles && run < allOrderings.count(); run++) {
+			QString msg= tr("best so far: %1 of %2 routed").arg(bestScore.totalRoutedCount).arg(totalToRoute);
+			if (m_pcbType) {
+				msg +=  tr(" with %n vias", "", bestScore.totalViaCount);
+			}
+			Q_EMIT setProgressMessage(msg);
+			Q_EMIT setCycleMessage(tr("round %1 of:").arg(run + 1));
+			Q_EMIT setProgressValue(run);
+			ProcessEventBlocker::processEvents();
+			currentScore.setOrdering(allOrderings.at(run));
+			currentScore.anyUnrouted = false;
+			routeNets(netList, false, currentScore, gridSize, allOrderings);
+			if (betterScore(currentScore, bestScore)) {
 				bestScore = currentScore;
 			}
+			if (m_cancelled || bestScore.anyUnrouted == false || m_stopTracing) break;
 		}
-		if (m_cancelled || bestScore.anyUnrouted == false || m_stopTracing) break;
 	}
+	DebugDialog::debug(QString("autorouter %1 mode: %2 of %3 routed, %4 vias, %5 rounds, %6 ms")
+	                   .arg(m_negotiated ? "negotiated" : "ordering")
+	                   .arg(bestScore.totalRoutedCount).arg(totalToRoute).arg(bestScore.totalViaCount)
+	                   .arg(qMin(run + 1, m_maxCycles)).arg(routeTimer.elapsed()));
+	DebugDialog::debug(QString("autorouter %1 search: %2 ms, %3 widenings")
+	                   .arg(m_windowedSearch ? "windowed" : "whole board")
+	                   .arg(m_searchNSecs / 1000000).arg(m_searchWidenings));
 
 	Q_EMIT disableButtons();
 
@@ -1029,11 +1090,7 @@ bool MazeRouter::routeNets(NetList & netList, bool makeJumper, Score & currentSc
 			// should only be here when makeJumpers = true
 			// remove the set of routed traces for this net--the net was not completely routed
 			// we didn't get all the way through before
-			currentScore.totalRoutedCount -= currentScore.routedCount.value(netIndex);
-			currentScore.routedCount.insert(netIndex, 0);
-			currentScore.totalViaCount -= currentScore.viaCount.value(netIndex);
-			currentScore.viaCount.insert(netIndex, 0);
-			currentScore.traces.remove(netIndex);
+			currentScore.ripUp(netIndex);
 		}
 
 		//foreach (ConnectorItem * connectorItem, *(net->net)) {
@@ -1065,7 +1122,12 @@ bool MazeRouter::routeNets(NetList & netList, bool makeJumper, Score & currentSc
 
 		QList<Trace> traces = currentScore.traces.values();
 		if (m_pcbType) {
-			traceObstacles(traces, netIndex, m_grid, m_keepoutGridInt);
+			if (m_negotiating) {
+				traceCongestion(currentScore.traces, netIndex);
+			}
+			else {
+				traceObstacles(traces, netIndex, m_grid, m_keepoutGridInt);
+			}
 		}
 		else {
 			traceAvoids(traces, netIndex, routeThing);
@@ -1146,18 +1208,125 @@ bool MazeRouter::routeNets(NetList & netList, bool makeJumper, Score & currentSc
 	return result;
 }
 
+int MazeRouter::routeNegotiated(NetList & netList, Score & bestScore, const QSizeF gridSize, int totalToRoute, QList<NetOrdering> & allOrderings)
+{
+	// PathFinder-style negotiation: nets may share space at a price that rises every round;
+	// only the nets that still overlap another net are ripped up and rerouted
+	int cells = m_grid->x * m_grid->y * m_grid->z;
+	m_history.fill(0, cells);
+	m_present.fill(0, cells);
+	m_netStamp.fill(0, cells);
+	m_presentCost = NegotiatedPresentCost;
+	m_negotiating = true;
+
+	Score currentScore;
+	currentScore.setOrdering(allOrderings.first());
+	auto run = 0;
+	for (; run < m_maxCycles; run++) {
+		QString msg = tr("best so far: %1 of %2 routed").arg(bestScore.totalRoutedCount).arg(totalToRoute);
+		msg += tr(" with %n vias", "", bestScore.totalViaCount);
+		Q_EMIT setProgressMessage(msg);
+		Q_EMIT setCycleMessage(tr("round %1 of:").arg(run + 1));
+		Q_EMIT setProgressValue(run);
+		ProcessEventBlocker::processEvents();
+
+		currentScore.anyUnrouted = false;
+		routeNets(netList, false, currentScore, gridSize, allOrderings);
+		if (m_cancelled || m_stopTracing) break;
+
+		// what is left after ripping up the overlapping nets is a legal partial result
+		int conflicts = negotiateCongestion(currentScore);
+		DebugDialog::debug(QString("negotiated round %1: %2 conflicting nets, %3 routed").arg(run + 1).arg(conflicts).arg(currentScore.totalRoutedCount));
+		if (betterScore(currentScore, bestScore)) {
+			bestScore = currentScore;
+		}
+		if (!currentScore.anyUnrouted) break;
+
+		m_presentCost = qMin(m_presentCost * 2, MaxPresentCost);
+	}
+
+	m_negotiating = false;
+	m_history.clear();
+	m_present.clear();
+	m_netStamp.clear();
+	return run;
+}
+
+int MazeRouter::negotiateCongestion(Score & score)
+{
+	m_present.fill(0);
+	m_netStamp.fill(0);
+	QList<int> netIndexes = score.traces.uniqueKeys();
+	Q_FOREACH (int netIndex, netIndexes) {
+		stampCongestion(score.traces.values(netIndex), netIndex);
+	}
+
+	// a net conflicts when its centerline runs inside another net's keepout
+	QList<int> conflicted;
+	Q_FOREACH (int netIndex, netIndexes) {
+		bool conflict = false;
+		Q_FOREACH (Trace trace, score.traces.values(netIndex)) {
+			Q_FOREACH (GridPoint gridPoint, trace.gridPoints) {
+				int cell = gridPointInt(m_grid, gridPoint);
+				if (m_present.at(cell) < 2) continue;
+
+				conflict = true;
+				m_history[cell] = qMin<quint16>(m_history.at(cell) + NegotiatedHistoryCost, MaxHistoryCost);
+			}
+		}
+		if (conflict) conflicted << netIndex;
+	}
+
+	Q_FOREACH (int netIndex, conflicted) {
+		score.ripUp(netIndex);
+		score.anyUnrouted = true;
+	}
+
+	return conflicted.count();
+}
+
 bool MazeRouter::routeOne(bool makeJumper, Score & currentScore, int netIndex, RouteThing & routeThing, QList<NetOrdering> & allOrderings) {
 
 	//DebugDialog::debug("start route()");
 	Trace newTrace;
 	auto viaCount = 0;
-	routeThing.bestDistanceToSource = routeThing.bestDistanceToTarget = std::numeric_limits<double>::max();
-	//DebugDialog::debug(QString("jumper d %1, %2").arg(routeThing.bestDistanceToSource).arg(routeThing.bestDistanceToTarget));
 
-	newTrace.gridPoints = route(routeThing, viaCount);
-	if (m_cancelled || m_stopTracing) {
-		return false;
+	// search near the endpoints first and only widen the window (up to the whole board) when that fails
+	std::priority_queue<GridPoint> sourceSeeds(routeThing.sourceQ);
+	std::priority_queue<GridPoint> targetSeeds(routeThing.targetQ);
+	QRect gridRect(0, 0, m_grid->x, m_grid->y);
+	QRect seedRect = m_windowedSearch ? seedBounds(sourceSeeds).united(seedBounds(targetSeeds)) : QRect();
+	int margin = qMax(MinSearchMargin, qMax(seedRect.width(), seedRect.height()) / 2);
+	QElapsedTimer searchTimer;
+	searchTimer.start();
+	while (true) {
+		routeThing.window = seedRect.isNull() ? gridRect : seedRect.adjusted(-margin, -margin, margin, margin).intersected(gridRect);
+		routeThing.bestDistanceToSource = routeThing.bestDistanceToTarget = std::numeric_limits<double>::max();
+		//DebugDialog::debug(QString("jumper d %1, %2").arg(routeThing.bestDistanceToSource).arg(routeThing.bestDistanceToTarget));
+
+		newTrace.gridPoints = route(routeThing, viaCount);
+		if (m_cancelled || m_stopTracing) {
+			return false;
+		}
+
+		if (newTrace.gridPoints.count() > 0 || routeThing.window == gridRect) break;
+
+		// keep the endpoints, drop the failed wavefront, and retry in a larger window
+		clearExpansion(m_grid, routeThing.window, true);
+		// the wavefront wrote its costs over other traces' keepouts, so stamp them back
+		Q_FOREACH (int cell, routeThing.avoids) {
+			int x = cell % m_grid->x;
+			int y = cell / m_grid->x;
+			if (m_grid->at(x, y, 0) == 0) {
+				m_grid->setAt(x, y, 0, GridAvoid);
+			}
+		}
+		m_searchWidenings++;
+		routeThing.sourceQ = sourceSeeds;
+		routeThing.targetQ = targetSeeds;
+		margin *= 2;
 	}
+	m_searchNSecs += searchTimer.nsecsElapsed();
 
 	//DebugDialog::debug("after route()");
 
@@ -1166,6 +1335,11 @@ bool MazeRouter::routeOne(bool makeJumper, Score & currentScore, int netIndex, R
 		if (makeJumper) {
 			routeJumper(netIndex, routeThing, currentScore);
 		}
+		else if (m_negotiating) {
+			// other nets do not block this one, so reordering would not help
+			routeThing.unrouted = true;
+			currentScore.anyUnrouted = true;
+		}
 		else {
 			routeThing.unrouted = true;
 			if (currentScore.reorderNet < 0) {
@@ -1624,7 +1798,7 @@ QList<GridPoint> MazeRouter::route(RouteThing & routeThing, int & viaCount)
 		points.append(sourcePoints);
 	}
 
-	clearExpansion(m_grid);
+	clearExpansion(m_grid, routeThing.window, false);
 
 	//DebugDialog::debug(QString("done with route() %1").arg(points.count()));
 
@@ -1733,10 +1907,10 @@ void MazeRouter::expand(GridPoint & gridPoint, RouteThing & routeThing)
 	//if (debugit) {
 	//    DebugDialog::debug(QString("expand %1 %2 %3, %4").arg(gridPoint.x).arg(gridPoint.y).arg(gridPoint.z).arg(routeThing.pq.size()));
 	//}
-	if (gridPoint.x > 0) expandOne(gridPoint, routeThing, -1, 0, 0, false);
-	if (gridPoint.x < m_grid->x - 1) expandOne(gridPoint, routeThing, 1, 0, 0, false);
-	if (gridPoint.y > 0) expandOne(gridPoint, routeThing, 0, -1, 0, false);
-	if (gridPoint.y < m_grid->y - 1) expandOne(gridPoint, routeThing, 0, 1, 0, false);
+	if (gridPoint.x > routeThing.window.left()) expandOne(gridPoint, routeThing, -1, 0, 0, false);
+	if (gridPoint.x < routeThing.window.right()) expandOne(gridPoint, routeThing, 1, 0, 0, false);
+	if (gridPoint.y > routeThing.window.top()) expandOne(gridPoint, routeThing, 0, -1, 0, false);
+	if (gridPoint.y < routeThing.window.bottom()) expandOne(gridPoint, routeThing, 0, 1, 0, false);
 	if (m_bothSidesNow) {
 		if (gridPoint.z > 0) expandOne(gridPoint, routeThing, 0, 0, -1, true);
 		if (gridPoint.z < m_grid->z - 1) expandOne(gridPoint, routeThing, 0, 0, 1, true);
@@ -1831,6 +2005,11 @@ void MazeRouter::expandOne(GridPoint & gridPoint, RouteThing & routeThing, int d
 		next.baseCost += AvoidCost;
 	}
 	next.baseCost++;
+	if (m_negotiating && writeable) {
+		// space used by other nets and earlier conflicts is expensive but not blocked
+		int cell = gridPointInt(m_grid, next);
+		next.baseCost += m_history.at(cell) + (m_present.at(cell) * m_presentCost);
+	}
 
 
 	/*
@@ -1975,14 +2154,18 @@ void MazeRouter::updateDisplay(GridPoint & gridPoint) {
 	//}
 }
 
-void MazeRouter::clearExpansion(Grid * grid) {
-	// TODO: keep a list of expansion points instead?
+void MazeRouter::clearExpansion(Grid * grid, const QRect & window, bool keepEndpoints) {
+	// expansion never leaves the window, but avoid cells next to it may have become temp obstacles
+	QRect r = window.adjusted(-1, -1, 1, 1).intersected(QRect(0, 0, grid->x, grid->y));
 
 	for (int z = 0; z < grid->z; z++) {
-		for (int y = 0; y < grid->y; y++) {
-			for (int x = 0; x < grid->x; x++) {
+		for (int y = r.top(); y <= r.bottom(); y++) {
+			for (int x = r.left(); x <= r.right(); x++) {
 				GridValue val = grid->at(x, y, z);
 				if (val == 0 || val == GridPartObstacle || val == GridBoardObstacle) ;
+				else if (!keepEndpoints) grid->setAt(x, y, z, 0);
+				else if (val == GridSource || val == GridTarget || val == GridAvoid) ;
+				else if (val == GridTempObstacle) grid->setAt(x, y, z, GridAvoid);
 				else grid->setAt(x, y, z, 0);
 			}
 		}
@@ -2118,6 +2301,57 @@ void MazeRouter::traceAvoids(QList<Trace> & traces, int netIndex, RouteThing & r
 	}
 }
 
+void MazeRouter::traceCongestion(const QMultiHash<int, Trace> & traces, int netIndex) {
+	// count how many other nets claim each cell instead of blocking it
+	m_present.fill(0);
+	m_netStamp.fill(0);
+	Q_FOREACH (int otherIndex, traces.uniqueKeys()) {
+		if (otherIndex == netIndex) continue;
+
+		stampCongestion(traces.values(otherIndex), otherIndex);
+	}
+}
+
+void MazeRouter::stampCongestion(const QList<Trace> & traces, int netIndex) {
+	auto stamp = static_cast<quint16>(netIndex + 1);
+	Q_FOREACH (Trace trace, traces) {
+		Q_FOREACH (int cell, traceFootprint(trace, m_keepoutGridInt)) {
+			if (m_netStamp.at(cell) == stamp) continue;
+
+			m_netStamp[cell] = stamp;
+			if (m_present.at(cell) < std::numeric_limits<quint8>::max()) m_present[cell]++;
+		}
+	}
+}
+
+QList<int> MazeRouter::traceFootprint(const Trace & trace, int ikeepout) {
+	// the cells traceObstacles() would block for this trace
+	QList<int> cells;
+	if (trace.gridPoints.count() == 0) return cells;
+
+	int lastZ = trace.gridPoints.at(0).z;
+	Q_FOREACH (GridPoint gridPoint, trace.gridPoints) {
+		if (gridPoint.z != lastZ) {
+			appendSquare(cells, m_grid, gridPoint.x, gridPoint.y, 0, m_halfGridViaSize);
+			appendSquare(cells, m_grid, gridPoint.x, gridPoint.y, 1, m_halfGridViaSize);
+			lastZ = gridPoint.z;
+		}
+		else {
+			appendSquare(cells, m_grid, gridPoint.x, gridPoint.y, gridPoint.z, ikeepout);
+		}
+	}
+
+	if (trace.flags) {
+		GridPoint gridPoint = trace.gridPoints.first();
+		appendSquare(cells, m_grid, gridPoint.x, gridPoint.y, 0, m_halfGridJumperSize);
+		if (m_bothSidesNow) {
+			appendSquare(cells, m_grid, gridPoint.x, gridPoint.y, 1, m_halfGridJumperSize);
+		}
+	}
+
+	return cells;
+}
+
 void MazeRouter::cleanUpNets(NetList & netList) {
 	Q_FOREACH(Net * net, netList.nets) {
 		delete net;
@@ -2862,7 +3096,7 @@ void MazeRouter::routeJumper(int netIndex, RouteThing & routeThing, Score & curr
 	updateDisplay(0);
 	if (m_bothSidesNow) updateDisplay(1);
 
-	clearExpansion(m_grid);
+	clearExpansion(m_grid, routeThing.window, false);
 }
 
 GridPoint MazeRouter::lookForJumper(GridPoint initial, GridValue targetValue, QPoint targetLocation) {
@@ -27,6 +27,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QList>
 #include <QSet>
 #include <QPointF>
+#include <QRect>
 #include <QGraphicsItem>
 #include <QLine>
 #include <QProgressDialog>
@@ -94,6 +95,7 @@ struct Score {
 
 	Score() = default;
 	void setOrdering(const NetOrdering &);
+	void ripUp(int netIndex);
 };
 
 struct Nearest {
@@ -137,6 +139,7 @@ struct RouteThing {
 	std::priority_queue<GridPoint> targetQ;
 	QPoint gridSourcePoint;
 	QPoint gridTargetPoint;
+	QRect window;                   // expansion is confined to these grid cells
 	GridValue sourceValue;
 	GridValue targetValue;
 	double bestDistanceToTarget;
@@ -190,6 +193,8 @@ protected:
 	bool makeBoard(QImage *, double keepout, const QRectF & r);
 	bool makeMasters(QString &);
 	bool routeNets(NetList &, bool makeJumper, Score & currentScore, const QSizeF gridSize, QList<NetOrdering> & allOrderings);
+	int routeNegotiated(NetList &, Score & bestScore, const QSizeF gridSize, int totalToRoute, QList<NetOrdering> & allOrderings);
+	int negotiateCongestion(Score &);
 	bool routeOne(bool makeJumper, Score & currentScore, int netIndex, RouteThing &, QList<NetOrdering> & allOrderings);
 	void findNearestPair(QList< QList<ConnectorItem *> > & subnets, Nearest &);
 	void findNearestPair(QList< QList<ConnectorItem *> > & subnets, int i, QList<ConnectorItem *> & inet, Nearest &);
@@ -203,13 +208,16 @@ protected:
 	void updateDisplay(int iz);
 	void updateDisplay(Grid *, int iz);
 	void updateDisplay(GridPoint &);
-	void clearExpansion(Grid * grid);
+	void clearExpansion(Grid * grid, const QRect & window, bool keepEndpoints);
 	void prepSourceAndTarget(QDomDocument * masterdoc, RouteThing &, QList< QList<ConnectorItem *> > & subnets, int z, ViewLayer::ViewLayerPlacement);
 	bool moveBack(Score & currentScore, int index, QList<NetOrdering> & allOrderings);
 	void displayTrace(Trace &);
 	void initTraceDisplay();
 	void traceObstacles(QList<Trace> & traces, int netIndex, Grid * grid, int ikeepout);
 	void traceAvoids(QList<Trace> & traces, int netIndex, RouteThing & routeThing);
+	void traceCongestion(const QMultiHash<int, Trace> & traces, int netIndex);
+	void stampCongestion(const QList<Trace> & traces, int netIndex);
+	QList<int> traceFootprint(const Trace &, int ikeepout);
 	bool routeNext(bool makeJumper, RouteThing &, QList< QList<ConnectorItem *> > & subnets, Score & currentScore, int netIndex, QList<NetOrdering> & allOrderings);
 	void cleanUpNets(NetList &);
 	void createTraces(NetList & netList, Score & bestScore, QUndoCommand * parentCommand);
@@ -259,6 +267,15 @@ protected:
 	int m_cleanupCount;
 	int m_netLabelIndex;
 	int m_commandCount;
+	bool m_negotiated;
+	bool m_negotiating;
+	bool m_windowedSearch;
+	qint64 m_searchNSecs;               // time spent in route() searches, for comparing windowed and whole-board runs
+	int m_searchWidenings;
+	GridValue m_presentCost;
+	QVector<quint16> m_history;         // per grid cell cost of earlier conflicts in negotiated mode
+	QVector<quint8> m_present;          // per grid cell count of nets whose keepout covers it
+	QVector<quint16> m_netStamp;
 };
 
 #endif
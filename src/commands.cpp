@@ -26,6 +26,23 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "items/moduleidnames.h"
 #include "utils/bezier.h"
 
+#include <QTextStream>
+
+static QString elementToString(const QDomElement & element) {
+	if (element.isNull()) return QString();
+
+	QString string;
+	QTextStream stream(&string);
+	element.save(stream, 0);
+	return string;
+}
+
+static QDomElement elementFromString(const QString & string, QDomDocument & document) {
+	if (string.isEmpty() || !document.setContent(string)) return QDomElement();
+
+	return document.documentElement();
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void CommandProgress::setActive(bool active) {
@@ -45,6 +62,8 @@ void CommandProgress::emitRedo() {
 
 int SelectItemCommand::selectItemCommandID = 3;
 int ChangeNoteTextCommand::changeNoteTextCommandID = 5;
+int SetPropCommand::setPropCommandID = 6;
+int ChangeLabelTextCommand::changeLabelTextCommandID = 7;
 int BaseCommand::nextIndex = 0;
 CommandProgress BaseCommand::m_commandProgress;
 
@@ -180,6 +199,55 @@ int BaseCommand::totalChildCount(const QUndoCommand * command) {
 	return tcc;
 }
 
+qint64 BaseCommand::memoryFootprint() const {
+	return sizeof(BaseCommand) + text().size() * sizeof(QChar);
+}
+
+qint64 BaseCommand::spill(const QSharedPointer<UndoSpillFile> &) {
+	return 0;
+}
+
+qint64 BaseCommand::totalMemoryFootprint(const QUndoCommand * command) {
+	if (command == nullptr) return 0;
+
+	qint64 footprint = 0;
+	const auto * bcmd = dynamic_cast<const BaseCommand *>(command);
+	if (bcmd == nullptr) {
+		footprint = sizeof(QUndoCommand) + command->text().size() * sizeof(QChar);
+	}
+	else {
+		footprint = bcmd->memoryFootprint();
+		for (int i = 0; i < bcmd->subCommandCount(); i++) {
+			footprint += totalMemoryFootprint(bcmd->subCommand(i));
+		}
+	}
+
+	for (int i = 0; i < command->childCount(); i++) {
+		footprint += totalMemoryFootprint(command->child(i));
+	}
+
+	return footprint;
+}
+
+qint64 BaseCommand::spillAll(QUndoCommand * command, const QSharedPointer<UndoSpillFile> & spillFile) {
+	if (command == nullptr) return 0;
+
+	qint64 freed = 0;
+	auto * bcmd = dynamic_cast<BaseCommand *>(command);
+	if (bcmd != nullptr) {
+		freed += bcmd->spill(spillFile);
+		Q_FOREACH (BaseCommand * subCommand, bcmd->m_commands) {
+			freed += spillAll(subCommand, spillFile);
+		}
+	}
+
+	for (int i = 0; i < command->childCount(); i++) {
+		freed += spillAll((QUndoCommand *) command->child(i), spillFile);
+	}
+
+	return freed;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 AddDeleteItemCommand::AddDeleteItemCommand(SketchWidget* sketchWidget, BaseCommand::CrossViewType crossViewType, QString moduleID, ViewLayer::ViewLayerPlacement viewLayerPlacement, ViewGeometry & viewGeometry, qint64 id, long modelIndex, QHash<QString, QString> * localConnectors, QUndoCommand *parent)
@@ -222,6 +290,18 @@ SketchWidget * AddDeleteItemCommand::dropOrigin() {
 	return m_dropOrigin;
 }
 
+qint64 AddDeleteItemCommand::memoryFootprint() const {
+	qint64 footprint = SimulationCommand::memoryFootprint()
+	                   + sizeof(ViewGeometry)
+	                   + m_moduleID.size() * sizeof(QChar);
+	if (m_localConnectors != nullptr) {
+		for (auto it = m_localConnectors->constBegin(); it != m_localConnectors->constEnd(); ++it) {
+			footprint += (it.key().size() + it.value().size()) * sizeof(QChar);
+		}
+	}
+	return footprint;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 SimulationCommand::SimulationCommand(BaseCommand::CrossViewType crossViewType, SketchWidget* sketchWidget, QUndoCommand *parent)
@@ -438,6 +518,12 @@ void MoveItemsCommand::addItem(long id, const QPointF & oldPos, const QPointF &
 	m_items.append(moveItemThing);
 }
 
+qint64 MoveItemsCommand::memoryFootprint() const {
+	return SimulationCommand::memoryFootprint()
+	       + m_items.count() * sizeof(MoveItemThing)
+	       + m_wires.count() * (sizeof(long) + sizeof(QString));
+}
+
 QString MoveItemsCommand::getParamString() const {
 	return QString("MoveItemsCommand ")
 	       + BaseCommand::getParamString() +
@@ -550,6 +636,10 @@ void ChangeConnectionCommand::disable() {
 	m_enabled = false;
 }
 
+qint64 ChangeConnectionCommand::memoryFootprint() const {
+	return SimulationCommand::memoryFootprint() + (m_fromConnectorID.size() + m_toConnectorID.size()) * sizeof(QChar);
+}
+
 QString ChangeConnectionCommand::getParamString() const {
 	return QString("ChangeConnectionCommand ")
 	       + BaseCommand::getParamString() +
@@ -700,6 +790,12 @@ void ChangeLegCommand::setSimple()
 	m_simple = true;
 }
 
+qint64 ChangeLegCommand::memoryFootprint() const {
+	return SimulationCommand::memoryFootprint()
+	       + (m_oldLeg.count() + m_newLeg.count()) * sizeof(QPointF)
+	       + (m_fromConnectorID.size() + m_why.size()) * sizeof(QChar);
+}
+
 void ChangeLegCommand::redo()
 {
 	if (!m_undoOnly) {
@@ -1044,6 +1140,10 @@ bool SelectItemCommand::mergeWith(const QUndoCommand *other)
 	return true;
 }
 
+qint64 SelectItemCommand::memoryFootprint() const {
+	return BaseCommand::memoryFootprint() + (m_undoIDs.count() + m_redoIDs.count()) * sizeof(long);
+}
+
 void SelectItemCommand::undo()
 {
 	selectAllFromStack(m_undoIDs, true, true);
@@ -1277,6 +1377,14 @@ CleanUpWiresCommand::Direction CleanUpWiresCommand::direction()
 	return m_direction;
 }
 
+qint64 CleanUpWiresCommand::memoryFootprint() const {
+	qint64 footprint = SimulationCommand::memoryFootprint() + m_sketchWidgets.count() * sizeof(SketchWidget *);
+	Q_FOREACH (const RatsnestConnectThing & rct, m_ratsnestConnectThings) {
+		footprint += sizeof(RatsnestConnectThing) + rct.connectorID.size() * sizeof(QChar);
+	}
+	return footprint;
+}
+
 void CleanUpWiresCommand::addTrace(SketchWidget * sketchWidget, Wire * wire)
 {
 	if (m_parentCommand) {
@@ -1473,24 +1581,38 @@ QString ShowLabelFirstTimeCommand::getParamString() const {
 RestoreLabelCommand::RestoreLabelCommand(SketchWidget *sketchWidget,long id, QDomElement & oldLabelGeometry, QDomElement & newLabelGeometry, QUndoCommand *parent)
 	: BaseCommand(BaseCommand::SingleView, sketchWidget, parent),
 	m_itemID(id),
-	m_oldLabelGeometry(oldLabelGeometry),
-	m_newLabelGeometry(newLabelGeometry)
+	m_oldLabelGeometry(elementToString(oldLabelGeometry)),
+	m_newLabelGeometry(elementToString(newLabelGeometry))
 {
-	// seems to be safe to keep a copy of the element even though the document may no longer exist
+	// keep the xml as text: holding the element would keep the whole paste or delete document alive
 }
 
 void RestoreLabelCommand::undo()
 {
-	m_sketchWidget->restorePartLabelForCommand(m_itemID, m_oldLabelGeometry);
+	QDomDocument document;
+	QDomElement labelGeometry = elementFromString(m_oldLabelGeometry.value(), document);
+	m_sketchWidget->restorePartLabelForCommand(m_itemID, labelGeometry);
 	BaseCommand::undo();
 }
 
 void RestoreLabelCommand::redo()
 {
-	m_sketchWidget->restorePartLabelForCommand(m_itemID, m_newLabelGeometry);
+	QDomDocument document;
+	QDomElement labelGeometry = elementFromString(m_newLabelGeometry.value(), document);
+	m_sketchWidget->restorePartLabelForCommand(m_itemID, labelGeometry);
 	BaseCommand::redo();
 }
 
+qint64 RestoreLabelCommand::memoryFootprint() const {
+	return BaseCommand::memoryFootprint()
+	       + m_oldLabelGeometry.memoryFootprint()
+	       + m_newLabelGeometry.memoryFootprint();
+}
+
+qint64 RestoreLabelCommand::spill(const QSharedPointer<UndoSpillFile> & spillFile) {
+	return m_oldLabelGeometry.spill(spillFile) + m_newLabelGeometry.spill(spillFile);
+}
+
 QString RestoreLabelCommand::getParamString() const {
 	return QString("RestoreLabelCommand ")
 	       + BaseCommand::getParamString()
@@ -1615,6 +1737,38 @@ void ChangeLabelTextCommand::redo() {
 	BaseCommand::redo();
 }
 
+int ChangeLabelTextCommand::id() const {
+	return changeLabelTextCommandID;
+}
+
+bool ChangeLabelTextCommand::mergeWith(const QUndoCommand *other)
+{
+	// "this" is earlier; "other" is later
+
+	if (other->id() != id()) {
+		return false;
+	}
+
+	const auto * sother = dynamic_cast<const ChangeLabelTextCommand *>(other);
+	if (sother == nullptr) return false;
+
+	if (sother->m_itemID != m_itemID || sother->m_sketchWidget != m_sketchWidget) {
+		return false;
+	}
+
+	m_newText = sother->m_newText;
+	setText(sother->text());
+	if (m_newText == m_oldText) {
+		// edited back to where it started
+		setObsolete(true);
+	}
+	return true;
+}
+
+qint64 ChangeLabelTextCommand::memoryFootprint() const {
+	return BaseCommand::memoryFootprint() + (m_oldText.size() + m_newText.size()) * sizeof(QChar);
+}
+
 QString ChangeLabelTextCommand::getParamString() const {
 	return QString("ChangeLabelTextCommand ")
 	       + BaseCommand::getParamString()
@@ -1709,6 +1863,10 @@ bool ChangeNoteTextCommand::mergeWith(const QUndoCommand *other)
 	return true;
 }
 
+qint64 ChangeNoteTextCommand::memoryFootprint() const {
+	return BaseCommand::memoryFootprint() + (m_oldText.size() + m_newText.size()) * sizeof(QChar);
+}
+
 QString ChangeNoteTextCommand::getParamString() const {
 	return QString("ChangeNoteTextCommand ")
 	       + BaseCommand::getParamString()
@@ -1890,15 +2048,56 @@ SetPropCommand::SetPropCommand(SketchWidget * sketchWidget, long itemID, QString
 }
 
 void SetPropCommand::undo() {
-	m_sketchWidget->setProp(m_itemID, m_prop, m_oldValue, m_redraw, true);
+	m_sketchWidget->setProp(m_itemID, m_prop, m_oldValue.value(), m_redraw, true);
 	SimulationCommand::undo();
 }
 
 void SetPropCommand::redo() {
-	m_sketchWidget->setProp(m_itemID, m_prop, m_newValue, m_redraw, true);
+	m_sketchWidget->setProp(m_itemID, m_prop, m_newValue.value(), m_redraw, true);
 	SimulationCommand::redo();
 }
 
+int SetPropCommand::id() const {
+	return setPropCommandID;
+}
+
+bool SetPropCommand::mergeWith(const QUndoCommand *other)
+{
+	// "this" is earlier; "other" is later
+	// only top-level commands are offered for merging, so this is a property edit
+	// from the Inspector rather than part of a larger operation
+
+	if (other->id() != id()) {
+		return false;
+	}
+
+	const auto * sother = dynamic_cast<const SetPropCommand *>(other);
+	if (sother == nullptr) return false;
+
+	if (sother->m_itemID != m_itemID || sother->m_sketchWidget != m_sketchWidget || sother->m_prop != m_prop || sother->m_redraw != m_redraw) {
+		return false;
+	}
+
+	m_newValue = sother->m_newValue;
+	setText(sother->text());
+	if (m_newValue.value() == m_oldValue.value()) {
+		// edited back to where it started
+		setObsolete(true);
+	}
+	return true;
+}
+
+qint64 SetPropCommand::memoryFootprint() const {
+	return SimulationCommand::memoryFootprint()
+	       + m_prop.size() * sizeof(QChar)
+	       + m_oldValue.memoryFootprint()
+	       + m_newValue.memoryFootprint();
+}
+
+qint64 SetPropCommand::spill(const QSharedPointer<UndoSpillFile> & spillFile) {
+	return m_oldValue.spill(spillFile) + m_newValue.spill(spillFile);
+}
+
 QString SetPropCommand::getParamString() const {
 
 	return QString("SetPropCommand ")
@@ -1906,8 +2105,8 @@ QString SetPropCommand::getParamString() const {
 	       QString(" id:%1 p:%2 o:%3 n:%4")
 	       .arg(m_itemID)
 	       .arg(m_prop)
-	       .arg(m_oldValue)
-	       .arg(m_newValue);
+	       .arg(m_oldValue.value())
+	       .arg(m_newValue.value());
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -2004,7 +2203,7 @@ LoadLogoImageCommand::LoadLogoImageCommand(SketchWidget *sketchWidget, long id,
 
 void LoadLogoImageCommand::undo() {
 	if (!m_redoOnly) {
-		m_sketchWidget->loadLogoImage(m_itemID, m_oldSvg, m_oldAspectRatio, m_oldFilename);
+		m_sketchWidget->loadLogoImage(m_itemID, m_oldSvg.value(), m_oldAspectRatio, m_oldFilename);
 	}
 	BaseCommand::undo();
 }
@@ -2018,6 +2217,16 @@ void LoadLogoImageCommand::redo() {
 	BaseCommand::redo();
 }
 
+qint64 LoadLogoImageCommand::memoryFootprint() const {
+	return BaseCommand::memoryFootprint()
+	       + m_oldSvg.memoryFootprint()
+	       + (m_oldFilename.size() + m_newFilename.size()) * sizeof(QChar);
+}
+
+qint64 LoadLogoImageCommand::spill(const QSharedPointer<UndoSpillFile> & spillFile) {
+	return m_oldSvg.spill(spillFile);
+}
+
 QString LoadLogoImageCommand::getParamString() const {
 	return QString("LoadLogoImageCommand ")
 	       + BaseCommand::getParamString()
@@ -2108,6 +2317,14 @@ void RenamePinsCommand::redo() {
 	BaseCommand::redo();
 }
 
+qint64 RenamePinsCommand::memoryFootprint() const {
+	qint64 footprint = BaseCommand::memoryFootprint();
+	Q_FOREACH (QString label, m_oldLabels + m_newLabels) {
+		footprint += label.size() * sizeof(QChar);
+	}
+	return footprint;
+}
+
 QString RenamePinsCommand::getParamString() const {
 	return QString("RenamePinsCommand ")
 	       + BaseCommand::getParamString()
@@ -2164,8 +2381,8 @@ WireExtrasCommand::WireExtrasCommand(SketchWidget* sketchWidget, long fromID,
                                      QUndoCommand *parent)
 	: BaseCommand(BaseCommand::SingleView, sketchWidget, parent),
 	m_fromID(fromID),
-	m_oldExtras(oldExtras),
-	m_newExtras(newExtras)
+	m_oldExtras(elementToString(oldExtras)),
+	m_newExtras(elementToString(newExtras))
 {
 
 }
@@ -2173,7 +2390,9 @@ WireExtrasCommand::WireExtrasCommand(SketchWidget* sketchWidget, long fromID,
 void WireExtrasCommand::undo()
 {
 	if (!m_redoOnly) {
-		m_sketchWidget->setWireExtrasForCommand(m_fromID, m_oldExtras);
+		QDomDocument document;
+		QDomElement extras = elementFromString(m_oldExtras.value(), document);
+		m_sketchWidget->setWireExtrasForCommand(m_fromID, extras);
 	}
 	BaseCommand::undo();
 }
@@ -2181,11 +2400,23 @@ void WireExtrasCommand::undo()
 void WireExtrasCommand::redo()
 {
 	if (!m_undoOnly) {
-		m_sketchWidget->setWireExtrasForCommand(m_fromID, m_newExtras);
+		QDomDocument document;
+		QDomElement extras = elementFromString(m_newExtras.value(), document);
+		m_sketchWidget->setWireExtrasForCommand(m_fromID, extras);
 	}
 	BaseCommand::redo();
 }
 
+qint64 WireExtrasCommand::memoryFootprint() const {
+	return BaseCommand::memoryFootprint()
+	       + m_oldExtras.memoryFootprint()
+	       + m_newExtras.memoryFootprint();
+}
+
+qint64 WireExtrasCommand::spill(const QSharedPointer<UndoSpillFile> & spillFile) {
+	return m_oldExtras.spill(spillFile) + m_newExtras.spill(spillFile);
+}
+
 QString WireExtrasCommand::getParamString() const {
 	return QString("WireExtrasCommand ")
 	       + BaseCommand::getParamString() +
@@ -28,6 +28,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "viewgeometry.h"
 #include "viewlayer.h"
 #include "routingstatus.h"
+#include "waitpushundostack.h"
 #include "utils/misc.h"
 #include "items/itembase.h"
 #include "mainwindow/mainwindow.h"
@@ -85,8 +86,12 @@ public:
 	void setSkipFirstRedo();
 	void undo();
 	void redo();
+	virtual qint64 memoryFootprint() const;
+	virtual qint64 spill(const QSharedPointer<UndoSpillFile> &);
 
 	static int totalChildCount(const QUndoCommand *);
+	static qint64 totalMemoryFootprint(const QUndoCommand *);
+	static qint64 spillAll(QUndoCommand *, const QSharedPointer<UndoSpillFile> &);
 	static CommandProgress * initProgress();
 	static void clearProgress();
 
@@ -131,6 +136,7 @@ public:
 	long itemID() const;
 	void setDropOrigin(SketchWidget *);
 	SketchWidget * dropOrigin();
+	qint64 memoryFootprint() const;
 
 protected:
 	QString getParamString() const;
@@ -231,6 +237,7 @@ public:
 	void redo();
 	void addItem(long id, const QPointF & oldPos, const QPointF & newPos);
 	void addWire(long id, const QString & connectorID);
+	qint64 memoryFootprint() const;
 
 protected:
 	QString getParamString() const;
@@ -309,6 +316,7 @@ public:
 	void redo();
 	void setUpdateConnections(bool updatem);
 	void disable();
+	qint64 memoryFootprint() const;
 
 protected:
 	QString getParamString() const;
@@ -382,6 +390,7 @@ public:
 	void redo();
 
 	void setSimple();
+	qint64 memoryFootprint() const;
 
 protected:
 	QString getParamString() const;
@@ -530,6 +539,7 @@ public:
 	void clearRedo();
 	int id() const;
 	bool mergeWith(const QUndoCommand *other);
+	qint64 memoryFootprint() const;
 	void copyUndo(SelectItemCommand * sother);
 	void copyRedo(SelectItemCommand * sother);
 	void setSelectItemType(SelectItemType);
@@ -701,6 +711,7 @@ public:
 	bool hasTraces(SketchWidget *);
 	void addRatsnestConnect(long id, const QString & connectorID, bool connect);
 	CleanUpWiresCommand::Direction direction();
+	qint64 memoryFootprint() const;
 
 protected:
 	QString getParamString() const;
@@ -733,14 +744,16 @@ public:
 	RestoreLabelCommand(class SketchWidget *sketchWidget, long id, QDomElement & oldLabelGeometry, QDomElement & newLabelGeometry, QUndoCommand *parent);
 	void undo();
 	void redo();
+	qint64 memoryFootprint() const;
+	qint64 spill(const QSharedPointer<UndoSpillFile> &);
 
 protected:
 	QString getParamString() const;
 
 protected:
 	long m_itemID;
-	QDomElement m_oldLabelGeometry;
-	QDomElement m_newLabelGeometry;
+	SpillableString m_oldLabelGeometry;
+	SpillableString m_newLabelGeometry;
 };
 
 /////////////////////////////////////////////
@@ -839,6 +852,9 @@ public:
 	ChangeLabelTextCommand(class SketchWidget *sketchWidget, long id, const QString & oldText, const QString & newText, QUndoCommand *parent);
 	void undo();
 	void redo();
+	int id() const;
+	bool mergeWith(const QUndoCommand *other);
+	qint64 memoryFootprint() const;
 
 protected:
 	QString getParamString() const;
@@ -847,6 +863,8 @@ protected:
 	long m_itemID;
 	QString m_oldText;
 	QString m_newText;
+
+	static int changeLabelTextCommandID;
 };
 
 /////////////////////////////////////////////
@@ -859,6 +877,7 @@ public:
 	void redo();
 	int id() const;
 	bool mergeWith(const QUndoCommand *other);
+	qint64 memoryFootprint() const;
 
 protected:
 	QString getParamString() const;
@@ -957,6 +976,10 @@ public:
 	SetPropCommand(class SketchWidget *, long itemID, QString prop, QString oldValue, QString newValue, bool redraw, QUndoCommand * parent);
 	void undo();
 	void redo();
+	int id() const;
+	bool mergeWith(const QUndoCommand *other);
+	qint64 memoryFootprint() const;
+	qint64 spill(const QSharedPointer<UndoSpillFile> &);
 
 protected:
 	QString getParamString() const;
@@ -964,9 +987,11 @@ protected:
 protected:
 	bool m_redraw;
 	QString m_prop;
-	QString m_oldValue;
-	QString m_newValue;
+	SpillableString m_oldValue;
+	SpillableString m_newValue;
 	long m_itemID;
+
+	static int setPropCommandID;
 };
 
 /////////////////////////////////////////////
@@ -1018,13 +1043,15 @@ public:
 	LoadLogoImageCommand(class SketchWidget *sketchWidget, long id, const QString & oldSvg, const QSizeF oldAspectRatio, const QString & oldFilename, const QString & newFilename, bool addName, QUndoCommand *parent);
 	void undo();
 	void redo();
+	qint64 memoryFootprint() const;
+	qint64 spill(const QSharedPointer<UndoSpillFile> &);
 
 protected:
 	QString getParamString() const;
 
 protected:
 	long m_itemID;
-	QString m_oldSvg;
+	SpillableString m_oldSvg;
 	QSizeF m_oldAspectRatio;
 	QString m_oldFilename;
 	QString m_newFilename;
@@ -1073,6 +1100,7 @@ public:
 	RenamePinsCommand(class SketchWidget *sketchWidget, long id, const QStringList & oldOnes, const QStringList & newOnes, QUndoCommand *parent);
 	void undo();
 	void redo();
+	qint64 memoryFootprint() const;
 
 protected:
 	QString getParamString() const;
@@ -1116,14 +1144,16 @@ public:
 	                  QUndoCommand *parent);
 	void undo();
 	void redo();
+	qint64 memoryFootprint() const;
+	qint64 spill(const QSharedPointer<UndoSpillFile> &);
 
 protected:
 	QString getParamString() const;
 
 protected:
 	long m_fromID;
-	QDomElement m_oldExtras;
-	QDomElement m_newExtras;
+	SpillableString m_oldExtras;
+	SpillableString m_newExtras;
 
 };
 
@@ -0,0 +1,161 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+
+#include "connectorindex.h"
+#include "connectoritem.h"
+
+#include <QGraphicsScene>
+#include <QPainterPath>
+#include <QSet>
+
+#include <algorithm>
+#include <cmath>
+
+// a little over two breadboard pitches, so most connectors land in one or two cells
+static constexpr double CellSize = 24;
+
+// connectors spanning more cells than this (rails, large pads) are checked on every query
+static constexpr int MaxCellsPerConnector = 64;
+
+quint64 ConnectorIndex::cellKey(int x, int y) {
+	return (quint64(quint32(x)) << 32) | quint32(y);
+}
+
+void ConnectorIndex::build(QGraphicsScene * scene) {
+	clear();
+	m_built = true;
+	if (!scene) return;
+
+	Q_FOREACH (QGraphicsItem * item, scene->items()) {
+		auto * connectorItem = dynamic_cast<ConnectorItem *>(item);
+		if (!connectorItem) continue;
+		if (!connectorItem->connector()) continue;
+
+		QRectF r = connectorItem->sceneBoundingRect();
+		int x0 = std::floor(r.left() / CellSize);
+		int x1 = std::floor(r.right() / CellSize);
+		int y0 = std::floor(r.top() / CellSize);
+		int y1 = std::floor(r.bottom() / CellSize);
+		m_count++;
+		if ((x1 - x0 + 1) * (y1 - y0 + 1) > MaxCellsPerConnector) {
+			m_oversized.append(connectorItem);
+			continue;
+		}
+
+		for (int x = x0; x <= x1; x++) {
+			for (int y = y0; y <= y1; y++) {
+				m_cells[cellKey(x, y)].append(connectorItem);
+			}
+		}
+	}
+}
+
+void ConnectorIndex::clear() {
+	m_cells.clear();
+	m_oversized.clear();
+	m_count = 0;
+	m_built = false;
+}
+
+bool ConnectorIndex::isBuilt() const {
+	return m_built;
+}
+
+int ConnectorIndex::count() const {
+	return m_count;
+}
+
+QList<ConnectorItem *> ConnectorIndex::connectorsAt(const QPointF & scenePos) const {
+	QList<ConnectorItem *> result;
+	auto check = [&result, &scenePos](ConnectorItem * connectorItem) {
+		if (!connectorItem || !connectorItem->scene()) return;
+		if (!connectorItem->isVisible()) return;
+		if (!connectorItem->sceneBoundingRect().contains(scenePos)) return;
+		if (!connectorItem->contains(connectorItem->mapFromScene(scenePos))) return;
+
+		result.append(connectorItem);
+	};
+
+	Q_FOREACH (QPointer<ConnectorItem> connectorItem, m_cells.value(cellKey(std::floor(scenePos.x() / CellSize), std::floor(scenePos.y() / CellSize)))) {
+		check(connectorItem);
+	}
+	Q_FOREACH (QPointer<ConnectorItem> connectorItem, m_oversized) {
+		check(connectorItem);
+	}
+
+	sortByStacking(result);
+	return result;
+}
+
+QList<ConnectorItem *> ConnectorIndex::connectorsIn(const QPolygonF & scenePolygon) const {
+	QList<ConnectorItem *> result;
+	QRectF bounds = scenePolygon.boundingRect();
+	QPainterPath path;
+	path.addPolygon(scenePolygon);
+	path.closeSubpath();
+
+	QSet<ConnectorItem *> checked;
+	auto check = [&result, &checked, &bounds, &path](ConnectorItem * connectorItem) {
+		if (!connectorItem || !connectorItem->scene()) return;
+		if (checked.contains(connectorItem)) return;
+
+		checked.insert(connectorItem);
+		if (!connectorItem->isVisible()) return;
+		if (!connectorItem->sceneBoundingRect().intersects(bounds)) return;
+		if (!connectorItem->collidesWithPath(connectorItem->mapFromScene(path))) return;
+
+		result.append(connectorItem);
+	};
+
+	int x0 = std::floor(bounds.left() / CellSize);
+	int x1 = std::floor(bounds.right() / CellSize);
+	int y0 = std::floor(bounds.top() / CellSize);
+	int y1 = std::floor(bounds.bottom() / CellSize);
+	for (int x = x0; x <= x1; x++) {
+		for (int y = y0; y <= y1; y++) {
+			auto it = m_cells.constFind(cellKey(x, y));
+			if (it == m_cells.constEnd()) continue;
+
+			Q_FOREACH (QPointer<ConnectorItem> connectorItem, it.value()) {
+				check(connectorItem);
+			}
+		}
+	}
+	Q_FOREACH (QPointer<ConnectorItem> connectorItem, m_oversized) {
+		check(connectorItem);
+	}
+
+	sortByStacking(result);
+	return result;
+}
+
+void ConnectorIndex::sortByStacking(QList<ConnectorItem *> & connectorItems) {
+	// approximate the topmost-first order of QGraphicsScene::items(); connector z values are local to their part
+	if (connectorItems.count() < 2) return;
+
+	std::stable_sort(connectorItems.begin(), connectorItems.end(), [](ConnectorItem * a, ConnectorItem * b) {
+		double za = a->parentItem() ? a->parentItem()->zValue() : a->zValue();
+		double zb = b->parentItem() ? b->parentItem()->zValue() : b->zValue();
+		if (za != zb) return za > zb;
+
+		return a->zValue() > b->zValue();
+	});
+}
@@ -0,0 +1,60 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+
+#ifndef CONNECTORINDEX_H
+#define CONNECTORINDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QPointer>
+#include <QPolygonF>
+
+class ConnectorItem;
+class QGraphicsScene;
+
+class ConnectorIndex
+{
+	// A grid of connector scene rects, built once when a drag starts and dropped when it ends.
+	// Entries are located by their position at build time but every hit is checked against
+	// the connector's live geometry, so items moving during the drag can only be missed, never
+	// reported at a stale position. Connectors deleted in the meantime are skipped.
+
+public:
+	void build(QGraphicsScene *);
+	void clear();
+	bool isBuilt() const;
+	int count() const;
+
+	QList<ConnectorItem *> connectorsAt(const QPointF & scenePos) const;
+	QList<ConnectorItem *> connectorsIn(const QPolygonF & scenePolygon) const;
+
+protected:
+	static quint64 cellKey(int x, int y);
+	static void sortByStacking(QList<ConnectorItem *> &);
+
+protected:
+	QHash<quint64, QList<QPointer<ConnectorItem> > > m_cells;
+	QList<QPointer<ConnectorItem> > m_oversized;
+	int m_count = 0;
+	bool m_built = false;
+};
+
+#endif
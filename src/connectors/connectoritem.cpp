@@ -225,6 +225,7 @@ parts editor support
 #include "../utils/bezierdisplay.h"
 #include "../utils/cursormaster.h"
 #include "ercdata.h"
+#include "connectorindex.h"
 #include "utils/ftooltip.h"
 #include "utils/misc.h"
 
@@ -1976,16 +1977,30 @@ double ConnectorItem::minDimension() {
 
 ConnectorItem * ConnectorItem::findConnectorUnder(bool useTerminalPoint, bool allowAlready, const QList<ConnectorItem *> & exclude, bool displayDragTooltip, ConnectorItem * other)
 {
-	QList<QGraphicsItem *> items = useTerminalPoint
-	                               ? this->scene()->items(this->sceneAdjustedTerminalPoint(nullptr))
-	                               : this->scene()->items(mapToScene(this->rect()));  // only wires use rect
+	QList<ConnectorItem *> connectorItems;
+	InfoGraphicsView * infoGraphicsView = InfoGraphicsView::getInfoGraphicsView(this);
+	ConnectorIndex * connectorIndex = infoGraphicsView ? infoGraphicsView->dragConnectorIndex() : nullptr;
+	if (connectorIndex) {
+		// while dragging, skip the scene's index, which the moving items keep invalidating
+		connectorItems = useTerminalPoint
+		                 ? connectorIndex->connectorsAt(this->sceneAdjustedTerminalPoint(nullptr))
+		                 : connectorIndex->connectorsIn(mapToScene(this->rect()));  // only wires use rect
+	}
+	else {
+		QList<QGraphicsItem *> items = useTerminalPoint
+		                               ? this->scene()->items(this->sceneAdjustedTerminalPoint(nullptr))
+		                               : this->scene()->items(mapToScene(this->rect()));  // only wires use rect
+		Q_FOREACH (QGraphicsItem * item, items) {
+			auto * connectorItemUnder = dynamic_cast<ConnectorItem *>(item);
+			if (connectorItemUnder) connectorItems.append(connectorItemUnder);
+		}
+	}
+
 	QList<ConnectorItem *> candidates;
 	// for the moment, take the topmost ConnectorItem that doesn't belong to me
-	Q_FOREACH (QGraphicsItem * item, items) {
-		auto * connectorItemUnder = dynamic_cast<ConnectorItem *>(item);
-		if (!connectorItemUnder) continue;
+	Q_FOREACH (ConnectorItem * connectorItemUnder, connectorItems) {
 		if (!connectorItemUnder->connector()) continue;  // shouldn't happen
-		if (attachedTo()->childItems().contains(connectorItemUnder)) continue;  // don't use own connectors
+		if (connectorItemUnder->parentItem() == attachedTo()) continue;  // don't use own connectors
 		if (!this->connectionIsAllowed(connectorItemUnder)) {
 			continue;
 		}
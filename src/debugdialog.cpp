@@ -32,6 +32,9 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QDir>
 #include <QtDebug>
 #include <QIcon>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
 
 const QMap<QString, QString> DebugDialog::colorMap = {
 	{ "<RESET>", "\033[0m" },
@@ -114,6 +117,10 @@ bool DebugDialog::m_enabled = false;
 bool DebugDialog::m_enabled = true;
 #endif
 
+// debug() is called from worker threads too (the svg layer cache and the KiCad and gEDA
+// conversion pools), so the log file and the singleton are only touched under this lock
+static QMutex DebugMutex;
+
 QEvent::Type DebugEventType = (QEvent::Type) (QEvent::User + 1);
 
 class DebugEvent : public QEvent
@@ -236,13 +243,18 @@ void DebugDialog::debug(QString message, DebugLevel debugLevel, QObject * ancest
 
 	if (!m_enabled) return;
 
+	QMutexLocker locker(&DebugMutex);
 
-	if (singleton == nullptr) {
+	// the dialog is a widget, so only the gui thread may create it; until then other threads just log
+	QCoreApplication * app = QCoreApplication::instance();
+	bool guiThread = app != nullptr && QThread::currentThread() == app->thread();
+	if (singleton == nullptr && guiThread) {
 		new DebugDialog();
 		//singleton->show();
 	}
 
-	if (debugLevel < singleton->m_debugLevel) {
+	DebugLevel minimumLevel = (singleton == nullptr) ? DebugDialog::Debug : singleton->m_debugLevel;
+	if (debugLevel < minimumLevel) {
 		return;
 	}
 
@@ -271,8 +283,11 @@ void DebugDialog::debug(QString message, DebugLevel debugLevel, QObject * ancest
 		out << message << "\n";
 		m_file.close();
 	}
-	auto* de = new DebugEvent(message, debugLevel, ancestor);
-	QCoreApplication::postEvent(singleton, de);
+	if (singleton != nullptr) {
+		// posted events are delivered on the dialog's (gui) thread
+		auto* de = new DebugEvent(message, debugLevel, ancestor);
+		QCoreApplication::postEvent(singleton, de);
+	}
 }
 
 void DebugDialog::hideDebug() {
@@ -311,6 +326,7 @@ bool DebugDialog::connectToBroadcast(QObject * receiver, const char* slot) {
 }
 
 void DebugDialog::setDebugLevel(DebugLevel debugLevel) {
+	QMutexLocker locker(&DebugMutex);
 	if (singleton == nullptr) {
 		new DebugDialog();
 
@@ -320,6 +336,7 @@ void DebugDialog::setDebugLevel(DebugLevel debugLevel) {
 }
 
 void DebugDialog::cleanup() {
+	QMutexLocker locker(&DebugMutex);
 	if (singleton != nullptr) {
 		delete singleton;
 		singleton = nullptr;
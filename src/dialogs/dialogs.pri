@@ -19,6 +19,7 @@ HEADERS += src/dialogs/prefsdialog.h \
         $$PWD/exportparametersdialog.h \
         src/dialogs/pinlabeldialog.h \
         src/dialogs/groundfillseeddialog.h \
+        src/dialogs/gerberpaneldialog.h \
         src/dialogs/quotedialog.h \
         src/dialogs/recoverydialog.h \
         src/dialogs/setcolordialog.h \
@@ -32,6 +33,7 @@ SOURCES += src/dialogs/prefsdialog.cpp \
         $$PWD/exportparametersdialog.cpp \
         src/dialogs/pinlabeldialog.cpp \
         src/dialogs/groundfillseeddialog.cpp \
+        src/dialogs/gerberpaneldialog.cpp \
         src/dialogs/quotedialog.cpp \
         src/dialogs/recoverydialog.cpp \
         src/dialogs/setcolordialog.cpp \
@@ -0,0 +1,124 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "gerberpaneldialog.h"
+
+#include <QDialogButtonBox>
+#include <QFormLayout>
+#include <QLabel>
+#include <QPushButton>
+#include <QSettings>
+#include <QVBoxLayout>
+
+static const QString ColumnsName("gerberPanel/columns");
+static const QString RowsName("gerberPanel/rows");
+static const QString GapName("gerberPanel/gapMM");
+static const QString RailName("gerberPanel/railMM");
+static const QString FiducialsName("gerberPanel/fiducials");
+static const QString MouseBitesName("gerberPanel/mouseBites");
+
+static constexpr double MillimetersPerInch = 25.4;
+
+/////////////////////////////////////////////////////////
+
+GerberPanelDialog::GerberPanelDialog(QWidget *parent) : QDialog(parent)
+{
+	QSettings settings;
+
+	this->setWindowTitle(tr("Panelized Gerber Export"));
+
+	auto * vLayout = new QVBoxLayout(this);
+
+	auto * label = new QLabel(tr("The board is exported once and repeated in a grid. "
+	                             "Boards are held to each other and to the rails by tabs in the middle of each facing edge."));
+	label->setWordWrap(true);
+	vLayout->addWidget(label);
+
+	auto * formLayout = new QFormLayout();
+
+	m_columnsSpinBox = new QSpinBox(this);
+	m_columnsSpinBox->setRange(1, 50);
+	m_columnsSpinBox->setValue(settings.value(ColumnsName, 2).toInt());
+	formLayout->addRow(tr("Columns:"), m_columnsSpinBox);
+
+	m_rowsSpinBox = new QSpinBox(this);
+	m_rowsSpinBox->setRange(1, 50);
+	m_rowsSpinBox->setValue(settings.value(RowsName, 2).toInt());
+	formLayout->addRow(tr("Rows:"), m_rowsSpinBox);
+
+	m_gapSpinBox = new QDoubleSpinBox(this);
+	m_gapSpinBox->setRange(0.5, 20);
+	m_gapSpinBox->setSingleStep(0.5);
+	m_gapSpinBox->setSuffix(" mm");
+	m_gapSpinBox->setValue(settings.value(GapName, 2.0).toDouble());
+	m_gapSpinBox->setToolTip(tr("Space between boards; usually the diameter of the fab's routing bit"));
+	formLayout->addRow(tr("Gap:"), m_gapSpinBox);
+
+	m_railSpinBox = new QDoubleSpinBox(this);
+	m_railSpinBox->setRange(0, 20);
+	m_railSpinBox->setSingleStep(0.5);
+	m_railSpinBox->setSuffix(" mm");
+	m_railSpinBox->setValue(settings.value(RailName, 5.0).toDouble());
+	m_railSpinBox->setToolTip(tr("Width of the rails along the top and bottom of the panel; 0 for no rails"));
+	formLayout->addRow(tr("Rail width:"), m_railSpinBox);
+
+	m_fiducialsCheckBox = new QCheckBox(tr("Fiducials on the rails"), this);
+	m_fiducialsCheckBox->setChecked(settings.value(FiducialsName, true).toBool());
+	formLayout->addRow(m_fiducialsCheckBox);
+
+	m_mouseBitesCheckBox = new QCheckBox(tr("Mouse-bite holes at the tabs"), this);
+	m_mouseBitesCheckBox->setChecked(settings.value(MouseBitesName, true).toBool());
+	formLayout->addRow(m_mouseBitesCheckBox);
+
+	vLayout->addLayout(formLayout);
+
+	auto * buttonBox = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel);
+	buttonBox->button(QDialogButtonBox::Cancel)->setText(tr("Cancel"));
+	buttonBox->button(QDialogButtonBox::Ok)->setText(tr("OK"));
+	connect(buttonBox, SIGNAL(accepted()), this, SLOT(accept()));
+	connect(buttonBox, SIGNAL(rejected()), this, SLOT(reject()));
+	vLayout->addWidget(buttonBox);
+
+	this->setLayout(vLayout);
+}
+
+GerberPanelDialog::~GerberPanelDialog()
+{
+}
+
+void GerberPanelDialog::accept() {
+	QSettings settings;
+	settings.setValue(ColumnsName, m_columnsSpinBox->value());
+	settings.setValue(RowsName, m_rowsSpinBox->value());
+	settings.setValue(GapName, m_gapSpinBox->value());
+	settings.setValue(RailName, m_railSpinBox->value());
+	settings.setValue(FiducialsName, m_fiducialsCheckBox->isChecked());
+	settings.setValue(MouseBitesName, m_mouseBitesCheckBox->isChecked());
+
+	QDialog::accept();
+}
+
+GerberPanel GerberPanelDialog::panel() const {
+	GerberPanel panel(m_columnsSpinBox->value(), m_rowsSpinBox->value(),
+	                  m_gapSpinBox->value() / MillimetersPerInch, m_railSpinBox->value() / MillimetersPerInch);
+	panel.setFiducials(m_fiducialsCheckBox->isChecked());
+	panel.setMouseBites(m_mouseBitesCheckBox->isChecked());
+	return panel;
+}
@@ -0,0 +1,53 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef GERBERPANELDIALOG_H
+#define GERBERPANELDIALOG_H
+
+#include <QDialog>
+#include <QSpinBox>
+#include <QDoubleSpinBox>
+#include <QCheckBox>
+
+#include "../svg/gerberpanel.h"
+
+class GerberPanelDialog : public QDialog
+{
+	Q_OBJECT
+
+public:
+	GerberPanelDialog(QWidget *parent = 0);
+	~GerberPanelDialog();
+
+	GerberPanel panel() const;
+
+public Q_SLOTS:
+	void accept();
+
+protected:
+	QSpinBox * m_columnsSpinBox;
+	QSpinBox * m_rowsSpinBox;
+	QDoubleSpinBox * m_gapSpinBox;
+	QDoubleSpinBox * m_railSpinBox;
+	QCheckBox * m_fiducialsCheckBox;
+	QCheckBox * m_mouseBitesCheckBox;
+};
+
+#endif
@@ -84,6 +84,10 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QTemporaryFile>
 #include <QDir>
 #include <QMetaType>
+#include <QtConcurrentMap>
+#include <QElapsedTimer>
+#include <QProcess>
+#include <QPixmapCache>
 
 #ifdef LINUX_32
 #define PLATFORM_NAME "linux-32bit"
@@ -110,6 +114,9 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 
 static constexpr double LoadProgressStart = 0.085;
 static constexpr double LoadProgressEnd = 0.6;
+static constexpr int PixmapCacheLimitKB = 64 * 1024;
+static constexpr int PasteBenchmarkRepeats = 5;
+static constexpr int PanBenchmarkFrames = 60;
 
 
 ////////////////////////////////////////////////////
@@ -532,6 +539,58 @@ int FApplication::init() {
 			toRemove << i << i + 1;
 		}
 
+		if ((m_arguments[i].compare("-mfg", Qt::CaseInsensitive) == 0) ||
+			(m_arguments[i].compare("-manufacturing", Qt::CaseInsensitive) == 0)||
+			(m_arguments[i].compare("--manufacturing", Qt::CaseInsensitive) == 0)) {
+			m_serviceType = ServiceType::ManufacturingService;
+			DebugDialog::setEnabled(true);
+			m_outputFolder = m_arguments[i + 1];
+			toRemove << i << i + 1;
+		}
+
+		if ((m_arguments[i].compare("-pastebench", Qt::CaseInsensitive) == 0) ||
+			(m_arguments[i].compare("--pastebench", Qt::CaseInsensitive) == 0)) {
+			m_serviceType = ServiceType::PasteBenchmarkService;
+			DebugDialog::setEnabled(true);
+			m_outputFolder = m_arguments[i + 1];
+			toRemove << i << i + 1;
+		}
+
+		if ((m_arguments[i].compare("-panbench", Qt::CaseInsensitive) == 0) ||
+			(m_arguments[i].compare("--panbench", Qt::CaseInsensitive) == 0)) {
+			m_serviceType = ServiceType::PanBenchmarkService;
+			DebugDialog::setEnabled(true);
+			m_outputFolder = m_arguments[i + 1];
+			toRemove << i << i + 1;
+		}
+
+		if ((m_arguments[i].compare("-routebench", Qt::CaseInsensitive) == 0) ||
+			(m_arguments[i].compare("--routebench", Qt::CaseInsensitive) == 0)) {
+			m_serviceType = ServiceType::RouteBenchmarkService;
+			DebugDialog::setEnabled(true);
+			m_outputFolder = m_arguments[i + 1];
+			toRemove << i << i + 1;
+		}
+
+		if ((m_arguments[i].compare("-formats", Qt::CaseInsensitive) == 0) ||
+			(m_arguments[i].compare("--formats", Qt::CaseInsensitive) == 0)) {
+			m_manufacturingFormats = m_arguments[i + 1].toLower().split(",", Qt::SkipEmptyParts);
+			toRemove << i << i + 1;
+		}
+
+		if ((m_arguments[i].compare("-j", Qt::CaseInsensitive) == 0) ||
+			(m_arguments[i].compare("-jobs", Qt::CaseInsensitive) == 0) ||
+			(m_arguments[i].compare("--jobs", Qt::CaseInsensitive) == 0)) {
+			m_serviceJobs = qMax(1, m_arguments[i + 1].toInt());
+			toRemove << i << i + 1;
+		}
+
+		if (m_arguments[i].compare("-shard", Qt::CaseInsensitive) == 0) {
+			// internal: set on the worker processes started by -jobs
+			m_serviceShard = m_arguments[i + 1].toInt();
+			toRemove << i << i + 1;
+		}
+
 		if (m_arguments[i].compare("-ep", Qt::CaseInsensitive) == 0) {
 			m_externalProcessPath = m_arguments[i + 1];
 			toRemove << i << i + 1;
@@ -901,10 +960,25 @@ int FApplication::serviceStartup() {
 		runExportAllService();
 		return 0;
 
+	case ServiceType::ManufacturingService:
+		return runManufacturingService() ? 0 : -1;
+
 	case ServiceType::SvgService:
 		runSvgService();
 		return 0;
 
+	case ServiceType::PasteBenchmarkService:
+		runPasteBenchmarkService();
+		return 0;
+
+	case ServiceType::PanBenchmarkService:
+		runPanBenchmarkService();
+		return 0;
+
+	case ServiceType::RouteBenchmarkService:
+		runRouteBenchmarkService();
+		return 0;
+
 	case ServiceType::ExampleService:
 		runExampleService();
 		return 0;
@@ -928,8 +1002,11 @@ QString FApplication::runServiceAux(ExportFunction exportFunc, int mainWindowArg
 	QStringList filenames = dir.entryList(filters, QDir::Files);
 	bool fail = false;
 	QStringList failedFiles;
-	Q_FOREACH (QString filename, filenames) {
-		QString filepath = dir.absoluteFilePath(filename);
+	for (int i = 0; i < filenames.count(); i++) {
+		// a worker process started by -jobs only takes every m_serviceJobs-th sketch
+		if (m_serviceShard >= 0 && i % m_serviceJobs != m_serviceShard) continue;
+
+		QString filepath = dir.absoluteFilePath(filenames.at(i));
 		MainWindow * mainWindow = openWindowForService(false, mainWindowArg);
 		m_started = true;
 
@@ -1029,6 +1106,133 @@ void FApplication::runExportAllService()
 	runExportAllServiceAux();
 }
 
+void FApplication::runPasteBenchmarkService()
+{
+	initService();
+	runServiceAux([](MainWindow* mainWindow, const QString& filepath, const QDir& /*dir*/) {
+		QFileInfo info(filepath);
+		QList<ViewLayer::ViewID> ids;
+		ids << ViewLayer::BreadboardView << ViewLayer::SchematicView << ViewLayer::PCBView;
+		Q_FOREACH (ViewLayer::ViewID id, ids) {
+			mainWindow->setCurrentView(id);
+			QString report = mainWindow->benchmarkPaste(PasteBenchmarkRepeats);
+			if (report.isEmpty()) continue;
+
+			DebugDialog::debug(QString("paste benchmark %1 %2").arg(info.fileName()).arg(report));
+		}
+	});
+}
+
+void FApplication::runPanBenchmarkService()
+{
+	initService();
+	runServiceAux([](MainWindow* mainWindow, const QString& filepath, const QDir& /*dir*/) {
+		QFileInfo info(filepath);
+		QList<ViewLayer::ViewID> ids;
+		ids << ViewLayer::BreadboardView << ViewLayer::SchematicView << ViewLayer::PCBView;
+		Q_FOREACH (ViewLayer::ViewID id, ids) {
+			mainWindow->setCurrentView(id);
+			QString report = mainWindow->benchmarkPan(PanBenchmarkFrames);
+			if (report.isEmpty()) continue;
+
+			DebugDialog::debug(QString("pan benchmark %1 %2").arg(info.fileName()).arg(report));
+		}
+	});
+}
+
+void FApplication::runRouteBenchmarkService()
+{
+	initService();
+	runServiceAux([](MainWindow* mainWindow, const QString& filepath, const QDir& /*dir*/) {
+		QFileInfo info(filepath);
+		mainWindow->setCurrentView(ViewLayer::PCBView);
+		QString report = mainWindow->benchmarkAutoroute();
+		if (report.isEmpty()) return;
+
+		DebugDialog::debug(QString("route benchmark %1 %2").arg(info.fileName()).arg(report));
+	});
+}
+
+bool FApplication::runManufacturingService()
+{
+	if (m_manufacturingFormats.isEmpty()) {
+		m_manufacturingFormats = MainWindow::ManufacturingFormats;
+	}
+	Q_FOREACH (QString format, m_manufacturingFormats) {
+		if (!MainWindow::ManufacturingFormats.contains(format)) {
+			DebugDialog::debug(QString("unknown manufacturing format %1").arg(format));
+			return false;
+		}
+	}
+
+	if (m_serviceJobs > 1 && m_serviceShard < 0) {
+		return runManufacturingServiceJobs();
+	}
+
+	initService();
+	QString error = runManufacturingServiceAux();
+	if (!error.isEmpty()) {
+		DebugDialog::debug(error);
+		return false;
+	}
+	return true;
+}
+
+QString FApplication::runManufacturingServiceAux() {
+	QStringList formats = m_manufacturingFormats;
+	QStringList failedExports;
+	QString error = runServiceAux([formats, &failedExports](MainWindow* mainWindow, const QString& filepath, const QDir& dir) {
+		QFileInfo info(filepath);
+		QStringList failed = mainWindow->exportManufacturingFiles(dir.absoluteFilePath(info.completeBaseName()), formats);
+		if (!failed.isEmpty()) {
+			failedExports.append(QString("%1 (%2)").arg(filepath, failed.join(",")));
+		}
+	});
+
+	if (!failedExports.isEmpty()) {
+		if (!error.isEmpty()) error += "; ";
+		error += "Export failed for files: " + failedExports.join(", ");
+	}
+	return error;
+}
+
+bool FApplication::runManufacturingServiceJobs()
+{
+	// sketches are loaded into graphics scenes, which only live on the gui thread,
+	// so run in parallel by starting more copies of ourselves, each taking a share of the folder
+	QStringList filters;
+	filters << "*" + FritzingBundleExtension;
+	int sketchCount = QDir(m_outputFolder).entryList(filters, QDir::Files).count();
+	int jobs = qMin(m_serviceJobs, sketchCount);
+	if (jobs <= 0) return true;
+
+	QStringList arguments = QCoreApplication::arguments().mid(1);
+	int ix = arguments.indexOf(QRegularExpression("-{1,2}j(obs)?", QRegularExpression::CaseInsensitiveOption));
+	if (ix >= 0 && ix + 1 < arguments.count()) {
+		arguments.removeAt(ix + 1);
+		arguments.removeAt(ix);
+	}
+	arguments << "-jobs" << QString::number(jobs);
+
+	QList<QProcess *> processes;
+	for (int shard = 0; shard < jobs; shard++) {
+		auto * process = new QProcess();
+		process->setProcessChannelMode(QProcess::ForwardedChannels);
+		process->start(QCoreApplication::applicationFilePath(), QStringList(arguments) << "-shard" << QString::number(shard));
+		processes << process;
+	}
+
+	bool ok = true;
+	Q_FOREACH (QProcess * process, processes) {
+		if (!process->waitForFinished(-1) || process->exitStatus() != QProcess::NormalExit || process->exitCode() != 0) {
+			DebugDialog::debug(QString("manufacturing export process %1 failed: %2").arg(processes.indexOf(process)).arg(process->errorString()));
+			ok = false;
+		}
+		delete process;
+	}
+	return ok;
+}
+
 void FApplication::initService()
 {
 	createUserDataStoreFolderStructures();
@@ -1074,30 +1278,105 @@ void FApplication::runDatabaseService()
 	loadReferenceModel(partsDB, true);
 }
 
-void FApplication::runGedaService() {
+struct ConversionJob {
+	QString filepath;
+	QString name;		// footprint or symbol within filepath; empty for gEDA
+	qint64 offset = -1;	// byte offset of name within filepath, from the library index
+	QString newFilePath;
+	QString message;
+};
+
+static QString legalFileName(QString name) {
+	Q_FOREACH (QChar c, QString("<>:\"/\\|?*")) {
+		name.remove(c);
+	}
+	return name;
+}
+
+static void writeConversion(ConversionJob & job, const QString & svg) {
+	if (svg.isEmpty()) {
+		job.message = "svg is empty " + job.filepath + " " + job.name;
+		return;
+	}
+
+	if (!TextUtils::writeUtf8(job.newFilePath, svg)) {
+		job.message = "unable to open file " + job.newFilePath;
+	}
+}
+
+// the conversion jobs run on pool threads; each converter instance is private to its job.
+// The converters log through DebugDialog, which serializes callers; the job's own result
+// message is still collected so the summary is logged in job order on the main thread
+static void runGedaJob(ConversionJob & job) {
 	try {
-		QDir dir(m_outputFolder);
-		QStringList filters;
-		filters << "*.fp";
-		QStringList filenames = dir.entryList(filters, QDir::Files);
-		Q_FOREACH (QString filename, filenames) {
-			QString filepath = dir.absoluteFilePath(filename);
-			QString newfilepath = filepath;
-			newfilepath.replace(".fp", ".svg");
-			GedaElement2Svg geda;
-			QString svg = geda.convert(filepath, false);
-			TextUtils::writeUtf8(newfilepath, svg);
-		}
+		GedaElement2Svg geda;
+		writeConversion(job, geda.convert(job.filepath, false));
 	}
 	catch (const QString & msg) {
-		DebugDialog::debug(msg);
+		job.message = msg;
 	}
 	catch (...) {
-		// Not sure why this was originally added.
-		DebugDialog::debug("runGedaService: discarding exception");
+		job.message = "runGedaService: discarding exception";
+	}
+}
+
+static void runKicadFootprintJob(ConversionJob & job) {
+	try {
+		KicadModule2Svg kicad;
+		writeConversion(job, kicad.convert(job.filepath, job.name, false, job.offset));
+	}
+	catch (const QString & msg) {
+		job.message = msg;
+	}
+	catch (...) {
+		job.message = "who knows";
 	}
 }
 
+static void runKicadSchematicJob(ConversionJob & job) {
+	try {
+		KicadSchematic2Svg kicad;
+		writeConversion(job, kicad.convert(job.filepath, job.name, job.offset));
+	}
+	catch (const QString & msg) {
+		job.message = msg;
+	}
+	catch (...) {
+		job.message = "who knows";
+	}
+}
+
+static void runConversionJobs(QList<ConversionJob> & jobs, void (*run)(ConversionJob &)) {
+	QElapsedTimer elapsedTimer;
+	elapsedTimer.start();
+
+	QtConcurrent::blockingMap(jobs, run);
+
+	Q_FOREACH (const ConversionJob & job, jobs) {
+		if (!job.message.isEmpty()) {
+			DebugDialog::debug(job.message);
+		}
+	}
+
+	DebugDialog::debug(QString("ran %1 conversions in %2 ms").arg(jobs.count()).arg(elapsedTimer.elapsed()));
+}
+
+void FApplication::runGedaService() {
+	QDir dir(m_outputFolder);
+	QStringList filters;
+	filters << "*.fp";
+	QStringList filenames = dir.entryList(filters, QDir::Files);
+	QList<ConversionJob> jobs;
+	Q_FOREACH (QString filename, filenames) {
+		ConversionJob job;
+		job.filepath = dir.absoluteFilePath(filename);
+		job.newFilePath = job.filepath;
+		job.newFilePath.replace(".fp", ".svg");
+		jobs.append(job);
+	}
+
+	runConversionJobs(jobs, &runGedaJob);
+}
 
 void FApplication::runDRCService() {
 	m_started = true;
@@ -1160,36 +1439,23 @@ void FApplication::runKicadFootprintService() {
 	QStringList filters;
 	filters << "*.mod";
 	QStringList filenames = dir.entryList(filters, QDir::Files);
+	QList<ConversionJob> jobs;
 	Q_FOREACH (QString filename, filenames) {
 		QString filepath = dir.absoluteFilePath(filename);
-		QStringList moduleNames = KicadModule2Svg::listModules(filepath);
+		QHash<QString, qint64> offsets;
+		QStringList moduleNames = KicadModule2Svg::listModules(filepath, &offsets);
 		Q_FOREACH (QString moduleName, moduleNames) {
-			KicadModule2Svg kicad;
-			try {
-				QString svg = kicad.convert(filepath, moduleName, false);
-				if (svg.isEmpty()) {
-					DebugDialog::debug("svg is empty " + filepath + " " + moduleName);
-					continue;
-				}
-				Q_FOREACH (QChar c, QString("<>:\"/\\|?*")) {
-					moduleName.remove(c);
-				}
-
-				QString newFilePath = dir.absoluteFilePath(moduleName + "_" + filename);
-				newFilePath.replace(".mod", ".svg");
-
-				if (!TextUtils::writeUtf8(newFilePath, svg)) {
-					DebugDialog::debug("unable to open file " + newFilePath);
-				}
-			}
-			catch (const QString & msg) {
-				DebugDialog::debug(msg);
-			}
-			catch (...) {
-				DebugDialog::debug("who knows");
-			}
+			ConversionJob job;
+			job.filepath = filepath;
+			job.name = moduleName;
+			job.offset = offsets.value(moduleName, -1);
+			job.newFilePath = dir.absoluteFilePath(legalFileName(moduleName) + "_" + filename);
+			job.newFilePath.replace(".mod", ".svg");
+			jobs.append(job);
 		}
 	}
+
+	runConversionJobs(jobs, &runKicadFootprintJob);
 }
 
 void FApplication::runKicadSchematicService() {
@@ -1197,44 +1463,33 @@ void FApplication::runKicadSchematicService() {
 	QStringList filters;
 	filters << "*.lib";
 	QStringList filenames = dir.entryList(filters, QDir::Files);
+	QList<ConversionJob> jobs;
 	Q_FOREACH (QString filename, filenames) {
 		QString filepath = dir.absoluteFilePath(filename);
-		QStringList defNames = KicadSchematic2Svg::listDefs(filepath);
+		QHash<QString, qint64> offsets;
+		QStringList defNames = KicadSchematic2Svg::listDefs(filepath, &offsets);
 		Q_FOREACH (QString defName, defNames) {
-			KicadSchematic2Svg kicad;
-			try {
-				QString svg = kicad.convert(filepath, defName);
-				if (svg.isEmpty()) {
-					DebugDialog::debug("svg is empty " + filepath + " " + defName);
-					continue;
-				}
-				Q_FOREACH (QChar c, QString("<>:\"/\\|?*")) {
-					defName.remove(c);
-				}
-
-				//DebugDialog::debug(QString("converting %1 %2").arg(defName).arg(filename));
-
-				QString newFilePath = dir.absoluteFilePath(defName + "_" + filename);
-				newFilePath.replace(".lib", ".svg");
-
-				if (!TextUtils::writeUtf8(newFilePath, svg)) {
-					DebugDialog::debug("unable to open file " + newFilePath);
-				}
-			}
-			catch (const QString & msg) {
-				DebugDialog::debug(msg);
-			}
-			catch (...) {
-				DebugDialog::debug("who knows");
-			}
+			ConversionJob job;
+			job.filepath = filepath;
+			job.name = defName;
+			job.offset = offsets.value(defName, -1);
+			job.newFilePath = dir.absoluteFilePath(legalFileName(defName) + "_" + filename);
+			job.newFilePath.replace(".lib", ".svg");
+			jobs.append(job);
 		}
 	}
+
+	runConversionJobs(jobs, &runKicadSchematicJob);
 }
 
 int FApplication::startup()
 {
 	//DebugDialog::setEnabled(true);
 
+	// one limit for every QPixmapCache user: zoomed-out sketches keep each part's item cache there
+	// (see SketchWidget::applyLevelOfDetail), and the default would evict them while panning
+	QPixmapCache::setCacheLimit(PixmapCacheLimitKB);
+
 	QString splashName = ":/resources/images/splash/splash_screen_start.png";
 	QDateTime now = QDateTime::currentDateTime();
 	if (now.date().month() == 4 && now.date().day() == 1) {
@@ -1940,12 +2195,7 @@ void FApplication::runExampleService(QDir & dir) {
 }
 
 void FApplication::cleanFzzs() {
-	QHash<QString, LockedFile *> lockedFiles;
-	QString folder;
-	LockManager::initLockedFiles("fzz", folder, lockedFiles, LockManager::SlowTime);
-	QFileInfoList backupList;
-	LockManager::checkLockedFiles("fzz", backupList, lockedFiles, true, LockManager::SlowTime);
-	LockManager::releaseLockedFiles(folder, lockedFiles);
+	LockManager::removeStaleFolders("fzz", true, LockManager::SlowTime);
 }
 
 void FApplication::newConnection(qintptr socketDescription) {
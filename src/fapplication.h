@@ -178,9 +178,15 @@ protected:
 	QString runIpcServiceAux();
 	void runExportAllService();
 	void runExportAllServiceAux();
+	bool runManufacturingService();
+	QString runManufacturingServiceAux();
+	bool runManufacturingServiceJobs();
 	QString runExportAllPlusSvgServiceAux();
 	void runSvgService();
 	QString runSvgServiceAux();
+	void runPasteBenchmarkService();
+	void runPanBenchmarkService();
+	void runRouteBenchmarkService();
 	void runExampleService();
 	void runExampleService(QDir &);
 	QList<class MainWindow *> recoverBackups();
@@ -208,6 +214,10 @@ protected:
 		PortService,
 		DRCService,
 		ExportAllService,
+		ManufacturingService,
+		PasteBenchmarkService,
+		PanBenchmarkService,
+		RouteBenchmarkService,
 		NoService
 	};
 
@@ -232,6 +242,9 @@ protected:
 	int m_progressIndex = 0;
 	class FSplashScreen * m_splash = nullptr;
 	QString m_outputFolder;
+	QStringList m_manufacturingFormats;
+	int m_serviceJobs = 1;
+	int m_serviceShard = -1;
 	QString m_portRootFolder;
 	QString m_panelFilename;
 	QHash<QString, struct LockedFile *> m_lockedFiles;
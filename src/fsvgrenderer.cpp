@@ -21,6 +21,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "fsvgrenderer.h"
 #include "debugdialog.h"
 #include "svg/svgfilesplitter.h"
+#include "svg/svgfixcache.h"
 #include "utils/fmessagebox.h"
 #include "utils/textutils.h"
 #include "utils/graphicsutils.h"
@@ -116,18 +117,27 @@ QByteArray FSvgRenderer::loadSvg(const QByteArray & contents, const LoadInfo & l
 
 QByteArray FSvgRenderer::loadAux(const QByteArray & theContents, const LoadInfo & loadInfo)
 {
-	QByteArray cleanContents(theContents);
-	bool cleaned = false;
-
-	QString string(cleanContents);
-	if (TextUtils::fixMuch(string, false)) {
-		cleaned = true;
-	}
-	if (TextUtils::fixPixelDimensionsIn(string)) {
-		cleaned = true;
-	}
-	if (cleaned) {
-		cleanContents = string.toUtf8();
+	QByteArray cleanContents;
+	// only file loads go through the disk cache; generated svg strings rarely repeat
+	bool cacheable = !loadInfo.filename.isEmpty();
+	const int fixFlags = SvgFixCache::FixMuch | SvgFixCache::FixPixelDimensions;
+	if (!cacheable || !SvgFixCache::find(theContents, fixFlags, cleanContents)) {
+		cleanContents = theContents;
+		bool cleaned = false;
+
+		QString string(cleanContents);
+		if (TextUtils::fixMuch(string, false)) {
+			cleaned = true;
+		}
+		if (TextUtils::fixPixelDimensionsIn(string)) {
+			cleaned = true;
+		}
+		if (cleaned) {
+			cleanContents = string.toUtf8();
+		}
+		if (cacheable) {
+			SvgFixCache::insert(theContents, fixFlags, cleanContents, cleaned);
+		}
 	}
 
 	QString errorStr;
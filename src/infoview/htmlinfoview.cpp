@@ -43,6 +43,9 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 static constexpr int MaxSpinBoxWidth = 60;
 static constexpr int AfterSpinBoxWidth = 5;
 
+static constexpr int SelectContentDelay = 10;  // ms
+static constexpr int HoverContentDelay = 120;  // ms; sweeping across parts only shows the one the mouse stops on
+
 /////////////////////////////////////
 QString format3(double d) {
 	return QString("%1").arg(d, 0, 'f', 3);
@@ -106,7 +109,7 @@ HtmlInfoView::HtmlInfoView(QWidget * parent) : QScrollArea(parent)
 	m_lastSwappingEnabled = false;
 	m_lastItemBase = nullptr;
 	m_setContentTimer.setSingleShot(true);
-	m_setContentTimer.setInterval(10);
+	m_setContentTimer.setInterval(SelectContentDelay);
 	connect(&m_setContentTimer, SIGNAL(timeout()), this, SLOT(setContent()));
 
 	m_currentItem = nullptr;
@@ -345,14 +348,14 @@ void HtmlInfoView::viewItemInfo(InfoGraphicsView *, ItemBase* item, bool swappin
 	m_setContentTimer.stop();
 	m_lastItemBase = m_pendingItemBase = item;
 	m_lastSwappingEnabled = m_pendingSwappingEnabled = swappingEnabled;
-	m_setContentTimer.start();
+	m_setContentTimer.start(SelectContentDelay);
 }
 
 void HtmlInfoView::hoverEnterItem(InfoGraphicsView *, QGraphicsSceneHoverEvent *, ItemBase * item, bool swappingEnabled) {
 	m_setContentTimer.stop();
 	m_pendingItemBase = item;
 	m_pendingSwappingEnabled = swappingEnabled;
-	m_setContentTimer.start();
+	m_setContentTimer.start(HoverContentDelay);
 }
 
 void HtmlInfoView::hoverLeaveItem(InfoGraphicsView *, QGraphicsSceneHoverEvent *, ItemBase * itemBase) {
@@ -361,7 +364,12 @@ void HtmlInfoView::hoverLeaveItem(InfoGraphicsView *, QGraphicsSceneHoverEvent *
 	m_setContentTimer.stop();
 	m_pendingItemBase = m_lastItemBase;
 	m_pendingSwappingEnabled = m_lastSwappingEnabled;
-	m_setContentTimer.start();
+	if (m_pendingItemBase == m_currentItem && m_pendingSwappingEnabled == m_currentSwappingEnabled) {
+		// the hovered item was never shown
+		return;
+	}
+
+	m_setContentTimer.start(HoverContentDelay);
 }
 
 void HtmlInfoView::viewConnectorItemInfo(QGraphicsSceneHoverEvent *, ConnectorItem * connectorItem) {
@@ -548,7 +556,7 @@ void HtmlInfoView::unregisterCurrentItem() {
 	m_setContentTimer.stop();
 	setCurrentItem(nullptr);
 	m_pendingItemBase = nullptr;
-	m_setContentTimer.start();
+	m_setContentTimer.start(SelectContentDelay);
 }
 
 void HtmlInfoView::unregisterCurrentItemIf(long id) {
@@ -32,6 +32,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../fsvgrenderer.h"
 #include "../svg/svgfilesplitter.h"
 #include "../svg/svgflattener.h"
+#include "../svg/svglayercache.h"
 #include "../utils/folderutils.h"
 #include "../utils/textutils.h"
 #include "../utils/graphicsutils.h"
@@ -52,6 +53,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QBitmap>
 #include <QApplication>
 #include <QClipboard>
+#include <QPixmapCache>
 #include <qmath.h>
 
 /////////////////////////////////
@@ -1287,6 +1289,31 @@ void ItemBase::prepareGeometryChange() {
 
 	//debugInfo("itembase prepare geometry change");
 	QGraphicsSvgItem::prepareGeometryChange();
+
+	// a level of detail cache has a fixed pixmap size, so resize it once the new geometry is in place
+	if (m_levelOfDetailScale > 0 && !m_levelOfDetailPending) {
+		m_levelOfDetailPending = true;
+		QTimer::singleShot(0, this, SLOT(refreshLevelOfDetailCache()));
+	}
+}
+
+void ItemBase::setLevelOfDetailCache(double scale) {
+	// scale 0 renders directly; otherwise keep a pixmap at the zoom bucket's resolution, which update() invalidates
+	m_levelOfDetailScale = scale;
+	if (scale <= 0) {
+		setCacheMode(QGraphicsItem::NoCache);
+		return;
+	}
+
+	QSizeF size = boundingRect().size() * scale;
+	setCacheMode(QGraphicsItem::ItemCoordinateCache, QSize(qMax(1, qCeil(size.width())), qMax(1, qCeil(size.height()))));
+}
+
+void ItemBase::refreshLevelOfDetailCache() {
+	m_levelOfDetailPending = false;
+	if (cacheMode() != QGraphicsItem::ItemCoordinateCache) return;  // dragging, or no longer zoomed out
+
+	setLevelOfDetailCache(m_levelOfDetailScale);
 }
 
 void ItemBase::saveLocAndTransform(QXmlStreamWriter & streamWriter)
@@ -1368,29 +1395,43 @@ FSvgRenderer * ItemBase::setUpImage(ModelPart * modelPart, LayerAttributes & lay
 	getFlipDoc(modelPart, filename, layerAttributes.viewLayerID, layerAttributes.viewLayerPlacement, flipDoc, layerAttributes.orientation);
 	QByteArray bytesToLoad;
 	if (layerAttributes.viewLayerID == ViewLayer::Schematic) {
-		bytesToLoad = SvgFileSplitter::hideText(filename);
+		if (!SvgLayerCache::find(filename, layerAttributes.viewLayerID, bytesToLoad)) {
+			bytesToLoad = SvgFileSplitter::hideText(filename);
+		}
 	}
 	else if (layerAttributes.viewLayerID == ViewLayer::SchematicText) {
-		bool hasText = false;
-		bytesToLoad = SvgFileSplitter::showText(filename, hasText);
-		if (!hasText) {
-			return nullptr;
+		if (SvgLayerCache::find(filename, layerAttributes.viewLayerID, bytesToLoad)) {
+			if (bytesToLoad.isEmpty()) {
+				return nullptr;
+			}
+		}
+		else {
+			bool hasText = false;
+			bytesToLoad = SvgFileSplitter::showText(filename, hasText);
+			if (!hasText) {
+				return nullptr;
+			}
 		}
 	}
 	else if ((layerAttributes.viewID != ViewLayer::IconView) && modelPartShared->hasMultipleLayers(layerAttributes.viewID)) {
 		QString layerName = ViewLayer::viewLayerXmlNameFromID(layerAttributes.viewLayerID);
 		// need to treat create "virtual" svg file for each layer
-		SvgFileSplitter svgFileSplitter;
-		bool result;
-		if (flipDoc.isNull()) {
-			result = svgFileSplitter.split(filename, layerName);
+		if (flipDoc.isNull() && SvgLayerCache::find(filename, layerAttributes.viewLayerID, bytesToLoad)) {
+			// already split while the sketch was being loaded
 		}
 		else {
-			QString f = flipDoc.toString();
-			result = svgFileSplitter.splitString(f, layerName);
-		}
-		if (result) {
-			bytesToLoad = svgFileSplitter.byteArray();
+			SvgFileSplitter svgFileSplitter;
+			bool result;
+			if (flipDoc.isNull()) {
+				result = svgFileSplitter.split(filename, layerName);
+			}
+			else {
+				QString f = flipDoc.toString();
+				result = svgFileSplitter.splitString(f, layerName);
+			}
+			if (result) {
+				bytesToLoad = svgFileSplitter.byteArray();
+			}
 		}
 	}
 	else {
@@ -2195,6 +2236,13 @@ QPixmap * ItemBase::getPixmap(ViewLayer::ViewID vid, bool swappingEnabled, QSize
 
 	if (!modelPart()->hasViewFor(vid)) return nullptr;
 
+	// views without an item are rendered from disk, and the inspector asks for them on every hover
+	QString cacheKey = QString("viewicon/%1/%2/%3x%4/%5").arg(moduleID()).arg(vid).arg(size.width()).arg(size.height()).arg(swappingEnabled);
+	QPixmap cached;
+	if (QPixmapCache::find(cacheKey, &cached)) {
+		return new QPixmap(cached);
+	}
+
 	QString baseName = modelPart()->hasBaseNameFor(vid);
 	if (baseName.isEmpty()) return nullptr;
 
@@ -2220,6 +2268,7 @@ QPixmap * ItemBase::getPixmap(ViewLayer::ViewID vid, bool swappingEnabled, QSize
 	renderer.render(&painter, bounds);
 	painter.end();
 
+	QPixmapCache::insert(cacheKey, *pixmap);
 	return pixmap;
 }
 
@@ -173,6 +173,7 @@ public:
 	virtual void collectWireConnectees(QSet<Wire *> & wires);
 	virtual bool collectFemaleConnectees(QSet<ItemBase *> & items);
 	void prepareGeometryChange();
+	void setLevelOfDetailCache(double scale);
 	virtual void resetID();
 	void updateConnectionsAux(bool includeRatsnest, QList<ConnectorItem *> & already);
 	void hoverEnterEvent( QGraphicsSceneHoverEvent * event );
@@ -326,6 +327,9 @@ public Q_SLOTS:
 	virtual void swapEntry(int index);
 	void showInFolder();
 
+protected Q_SLOTS:
+	void refreshLevelOfDetailCache();
+
 public:
 	static bool zLessThan(ItemBase * & p1, ItemBase * & p2);
 	static qint64 getNextID();
@@ -401,6 +405,8 @@ protected:
 	bool m_squashShape = false;
 	QPainterPath m_selectionShape;
 	QGraphicsObject * m_simItem = nullptr;
+	double m_levelOfDetailScale = 0;
+	bool m_levelOfDetailPending = false;
 
 protected:
 	static long nextID;
@@ -23,6 +23,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../debugdialog.h"
 #include "../fsvgrenderer.h"
 #include "../svg/svgfilesplitter.h"
+#include "../svg/svgfragmentcache.h"
 #include "../layerattributes.h"
 #include "layerkinpaletteitem.h"
 #include "../connectors/connectoritem.h"
@@ -621,13 +622,18 @@ QString PaletteItemBase::retrieveSvg(ViewLayer::ViewLayerID viewLayerID, QHash<Q
 		orientation = infoGraphicsView->smdOrientation();
 	}
 
-	QDomDocument flipDoc;
-	getFlipDoc(modelPart(), path, viewLayerID, m_viewLayerPlacement, flipDoc, orientation);
+	QString hashKey = path + xmlName + QString(QChar(m_viewLayerPlacement));
+	QString svg = svgHash.value(hashKey, "");
+	if (!svg.isEmpty()) return svg;
 
-	//DebugDialog::debug(QString("path: %1").arg(path));
+	QString cacheKey = SvgFragmentCache::key(path, moduleID(), viewLayerID, m_viewLayerPlacement, orientation, dpi, blackOnly, hasRubberBandLeg());
+	if (SvgFragmentCache::find(cacheKey, svg, factor)) {
+		svgHash.insert(hashKey, svg);
+		return svg;
+	}
 
-	QString svg = svgHash.value(path + xmlName + QString(QChar(m_viewLayerPlacement)), "");
-	if (!svg.isEmpty()) return svg;
+	QDomDocument flipDoc;
+	getFlipDoc(modelPart(), path, viewLayerID, m_viewLayerPlacement, flipDoc, orientation);
 
 	SvgFileSplitter splitter;
 
@@ -657,7 +663,8 @@ QString PaletteItemBase::retrieveSvg(ViewLayer::ViewLayerID viewLayerID, QHash<Q
 		return "";
 	}
 	svg = splitter.elementString(xmlName);
-	svgHash.insert(path + xmlName + QString(QChar(m_viewLayerPlacement)), svg);
+	svgHash.insert(hashKey, svg);
+	SvgFragmentCache::insert(cacheKey, svg, factor);
 	return svg;
 }
 
@@ -522,8 +522,7 @@ QString PartFactory::getFzpFilename(const QString & moduleID)
 void PartFactory::initFolder()
 {
 	LockManager::initLockedFiles("partfactory", PartFactoryFolderPath, LockedFiles, LockManager::SlowTime);
-	QFileInfoList backupList;
-	LockManager::checkLockedFiles("partfactory", backupList, LockedFiles, true, LockManager::SlowTime);
+	LockManager::removeStaleFolders("partfactory", true, LockManager::SlowTime);
 	FolderUtils::makePartFolderHierarchy(PartFactoryFolderPath, "core");
 	FolderUtils::makePartFolderHierarchy(PartFactoryFolderPath, "contrib");
 }
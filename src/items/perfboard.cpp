@@ -363,7 +363,7 @@ QString Perfboard::genModuleID(QMap<QString, QString> & currPropsMap)
 
 bool Perfboard::getXY(int & x, int & y, const QString & s)
 {
-	QRegularExpression re("(\\d+)\\.(\\d+)");
+	static const QRegularExpression re("(\\d+)\\.(\\d+)");
 
 	QRegularExpressionMatch match;
 	if (!s.contains(re, &match)) return false;
@@ -281,6 +281,7 @@ QString Stripbit::makeRemovedString() {
 StripConnector::StripConnector() {
 	down = right = nullptr;
 	connectorItem = nullptr;
+	downRemoved = rightRemoved = false;
 }
 
 struct StripLayout {
@@ -534,22 +535,6 @@ void Stripboard::reinitBuses(bool triggerUndo)
 	}
 	if (viewID() != ViewLayer::BreadboardView) return;
 
-	Q_FOREACH (BusShared * busShared, m_buses) delete busShared;
-	m_buses.clear();
-
-	Q_FOREACH (QGraphicsItem * item, childItems()) {
-		auto * stripbit = dynamic_cast<Stripbit *>(item);
-		if (stripbit == nullptr) {
-			auto * connectorItem = dynamic_cast<ConnectorItem *>(item);
-			if (connectorItem == nullptr) continue;
-
-			connectorItem->connector()->connectorShared()->setBus(nullptr);
-			connectorItem->connector()->setBus(nullptr);
-			continue;
-		}
-
-	}
-
 	QString busPropertyString;
 	Q_FOREACH (QGraphicsItem * item, childItems()) {
 		auto * stripbit = dynamic_cast<Stripbit *>(item);
@@ -560,68 +545,175 @@ void Stripboard::reinitBuses(bool triggerUndo)
 		}
 	}
 
-	QList<ConnectorItem *> visited;
-	for (int iy = 0; iy < m_y; iy++) {
-		for (int ix = 0; ix < m_x; ix++) {
-			StripConnector * sc = getStripConnector(ix, iy);
-			if (visited.contains(sc->connectorItem)) continue;
-
-			QList<ConnectorItem *> connected;
-			collectConnected(ix, iy, connected);
-			visited.append(connected);
-			nextBus(connected);
+	// only the buses on either side of a cut or restored strip can change
+	bool rebuild = (m_stripBus.count() != m_strips.count());
+	QList<int> affected;
+	if (!rebuild) {
+		for (int i = 0; i < m_strips.count(); i++) {
+			StripConnector * sc = m_strips.at(i);
+			if ((sc->right != nullptr) && sc->right->removed() != sc->rightRemoved) {
+				affected << i << i + 1;
+			}
+			if ((sc->down != nullptr) && sc->down->removed() != sc->downRemoved) {
+				affected << i << i + m_x;
+			}
 		}
 	}
 
-	modelPart()->clearBuses();
-	modelPart()->initBuses();
-	modelPart()->setLocalProp("buses",  busPropertyString);
-
+	if (rebuild) {
+		rebuildAllBuses();
+	}
+	else if (!affected.isEmpty()) {
+		updateBuses(affected);
+	}
 
+	if (rebuild || !affected.isEmpty()) {
+		modelPart()->clearBuses();
+		modelPart()->initBuses();
+	}
+	modelPart()->setLocalProp("buses",  busPropertyString);
 
 	QList<ConnectorItem *> visited2;
-	Q_FOREACH (ConnectorItem * connectorItem, cachedConnectorItems()) {
-		connectorItem->restoreColor(visited2);
+	if (rebuild) {
+		Q_FOREACH (ConnectorItem * connectorItem, cachedConnectorItems()) {
+			connectorItem->restoreColor(visited2);
+		}
+	}
+	else {
+		Q_FOREACH (int index, affected) {
+			ConnectorItem * connectorItem = m_strips.at(index)->connectorItem;
+			if (connectorItem != nullptr) {
+				connectorItem->restoreColor(visited2);
+			}
+		}
 	}
 
 	update();
 }
 
-void Stripboard::collectConnected(int ix, int iy, QList<ConnectorItem *> & connected) {
-	StripConnector * sc = getStripConnector(ix, iy);
-	if (connected.contains(sc->connectorItem)) return;
+void Stripboard::rebuildAllBuses() {
+	Q_FOREACH (BusShared * busShared, m_buses) delete busShared;
+	m_buses.clear();
+	m_busStrips.clear();
+	m_nextBusID = 0;
 
-	connected << sc->connectorItem;
+	Q_FOREACH (ConnectorItem * connectorItem, cachedConnectorItems()) {
+		connectorItem->connector()->connectorShared()->setBus(nullptr);
+		connectorItem->connector()->setBus(nullptr);
+	}
+
+	m_stripBus.fill(nullptr, m_strips.count());
+	QList<int> all;
+	all.reserve(m_strips.count());
+	for (int i = 0; i < m_strips.count(); i++) {
+		all.append(i);
+	}
+	updateBuses(all);
+}
 
-	if ((sc->right != nullptr) && !sc->right->removed()) {
-		collectConnected(ix + 1, iy, connected);
+void Stripboard::updateBuses(QList<int> & affected) {
+	// a changed strip can only join or split the buses its ends belonged to,
+	// so only the strip connectors on those buses need to be regrouped
+	QList<int> strips;
+	QHash<int, int> localIndex;
+	Q_FOREACH (int index, affected) {
+		BusShared * busShared = m_stripBus.at(index);
+		QList<int> members;
+		if (busShared == nullptr) {
+			members << index;
+		}
+		else {
+			members = m_busStrips.value(busShared);
+			deleteBus(busShared);
+		}
+		Q_FOREACH (int member, members) {
+			if (localIndex.contains(member)) continue;
 
+			localIndex.insert(member, strips.count());
+			strips.append(member);
+		}
 	}
-	if ((sc->down != nullptr) && !sc->down->removed()) {
-		collectConnected(ix, iy + 1, connected);
+
+	// union-find over the affected strip connectors
+	QVector<int> parent(strips.count());
+	for (int i = 0; i < parent.count(); i++) {
+		parent[i] = i;
+	}
+	auto find = [&parent](int i) {
+		while (parent[i] != i) {
+			parent[i] = parent[parent[i]];
+			i = parent[i];
+		}
+		return i;
+	};
+	auto unite = [&parent, &find](int a, int b) {
+		if (b < 0) return;
+
+		a = find(a);
+		b = find(b);
+		if (a < b) parent[b] = a;
+		else if (b < a) parent[a] = b;
+	};
+
+	for (int local = 0; local < strips.count(); local++) {
+		int index = strips.at(local);
+		StripConnector * sc = m_strips.at(index);
+		if (sc->right != nullptr) {
+			sc->rightRemoved = sc->right->removed();
+			if (!sc->rightRemoved) {
+				unite(local, localIndex.value(index + 1, -1));
+			}
+		}
+		if (sc->down != nullptr) {
+			sc->downRemoved = sc->down->removed();
+			if (!sc->downRemoved) {
+				unite(local, localIndex.value(index + m_x, -1));
+			}
+		}
 	}
 
-	StripConnector * left = ix > 0 ? getStripConnector(ix - 1, iy) : nullptr;
-	if ((left != nullptr) && (left->right != nullptr) && !left->right->removed()) {
-		collectConnected(ix - 1, iy, connected);
+	QHash<int, QList<int> > groups;
+	for (int local = 0; local < strips.count(); local++) {
+		groups[find(local)].append(strips.at(local));
 	}
+	for (int local = 0; local < strips.count(); local++) {
+		if (parent.at(local) != local) continue;
 
-	StripConnector * up = iy > 0 ? getStripConnector(ix, iy - 1) : nullptr;
-	if ((up != nullptr) && (up->down != nullptr) && !up->down->removed()) {
-		collectConnected(ix, iy - 1, connected);
+		nextBus(groups.value(local));
 	}
+
+	affected = strips;
 }
 
-void Stripboard::nextBus(QList<ConnectorItem *> & soFar)
+void Stripboard::deleteBus(BusShared * busShared) {
+	Q_FOREACH (int index, m_busStrips.value(busShared)) {
+		m_stripBus[index] = nullptr;
+		ConnectorItem * connectorItem = m_strips.at(index)->connectorItem;
+		if (connectorItem != nullptr) {
+			connectorItem->connector()->connectorShared()->setBus(nullptr);
+			connectorItem->connector()->setBus(nullptr);
+		}
+	}
+
+	m_busStrips.remove(busShared);
+	m_buses.removeOne(busShared);
+	delete busShared;
+}
+
+void Stripboard::nextBus(const QList<int> & soFar)
 {
 	if (soFar.count() > 1) {
-		auto * busShared = new BusShared(QString::number(m_buses.count()));
+		auto * busShared = new BusShared(QString::number(m_nextBusID++));
 		m_buses.append(busShared);
-		Q_FOREACH (ConnectorItem * connectorItem, soFar) {
-			busShared->addConnectorShared(connectorItem->connector()->connectorShared());
+		m_busStrips.insert(busShared, soFar);
+		Q_FOREACH (int index, soFar) {
+			m_stripBus[index] = busShared;
+			ConnectorItem * connectorItem = m_strips.at(index)->connectorItem;
+			if (connectorItem != nullptr) {
+				busShared->addConnectorShared(connectorItem->connector()->connectorShared());
+			}
 		}
 	}
-	soFar.clear();
 }
 
 void Stripboard::setProp(const QString & prop, const QString & value)
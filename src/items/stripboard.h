@@ -24,6 +24,8 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QRectF>
 #include <QPainterPath>
 #include <QGraphicsPathItem>
+#include <QHash>
+#include <QVector>
 
 #include "perfboard.h"
 
@@ -64,6 +66,8 @@ struct StripConnector {
 	ConnectorItem * connectorItem;
 	Stripbit * down;
 	Stripbit * right;
+	bool downRemoved;				// state of down and right when the buses were last built
+	bool rightRemoved;
 
 	StripConnector();
 };
@@ -92,11 +96,13 @@ protected Q_SLOTS:
 	void changeBoardSize();
 
 protected:
-	void nextBus(QList<ConnectorItem *> & soFar);
+	void nextBus(const QList<int> & soFar);
+	void rebuildAllBuses();
+	void updateBuses(QList<int> & affected);
+	void deleteBus(class BusShared *);
 	QString getRowLabel();
 	QString getColumnLabel();
 	void makeInitialPath();
-	void collectConnected(int x, int y, QList<ConnectorItem *> & connected);
 	StripConnector * getStripConnector(int x, int y);
 	void collectTo(QSet<ConnectorItem *> &);
 	void initStripLayouts();
@@ -109,6 +115,9 @@ public:
 protected:
 	QList<StripConnector *> m_strips;
 	QList<class BusShared *> m_buses;
+	QVector<class BusShared *> m_stripBus;				// bus of each strip connector, nullptr if it is not connected to another one
+	QHash<class BusShared *, QList<int> > m_busStrips;	// strip connector indexes of each bus
+	int m_nextBusID = 0;
 	QString m_beforeCut;
 	int m_x = 0;
 	int m_y = 0;
@@ -132,8 +132,11 @@ int main(int argc, char *argv[])
 			     "  -geda FOLDER                  convert all gEDA footprint (.fp) files in FOLDER to Fritzing SVGs\n"
 			     "  -g, -gerber FOLDER            export all sketches in FOLDER to Gerber, in the same folder\n"
 			     "  -h, -help                     print this help message\n"
+			     "  -j, -jobs NUMBER              with -mfg, process the sketches in NUMBER parallel Fritzing processes\n"
 			     "  -kicad FOLDER                 convert all Kicad footprint (.mod) files in FOLDER to Fritzing SVGs\n"
 			     "  -kicadschematic FOLDER        convert all Kicad schematic (.lib) files in FOLDER to Fritzing SVGs\n"
+			     "  -mfg, -manufacturing FOLDER   export manufacturing data for all sketches in FOLDER, in the same folder\n"
+			     "  -formats LIST                 with -mfg, comma separated subset of bom,netlist,spice,ipc,pnp (default: all)\n"
 			     "  -port NUMBER                  run Fritzing as a server process on port NUMBER\n"
 			     "  -svg FOLDER                   export all sketches in FOLDER to SVGs of all views, in the same folder\n"
 			     "\n"
@@ -145,8 +148,11 @@ int main(int argc, char *argv[])
 			     "  -ep FILE                      add menu item for external process using executable FILE\n"
 			     "  -eparg ARGS                   with -ep, external process arguments ARGS\n"
 			     "  -epname NAME                  with -ep, external process menu item NAME\n"
+			     "  -pastebench FOLDER            time copying and pasting all parts of each view, for all sketches in FOLDER\n"
+			     "  -panbench FOLDER              time redrawing each view while panning it at three zoom levels, for all sketches in FOLDER\n"
+			     "  -routebench FOLDER            autoroute each board in ordering and in negotiated mode, for all sketches in FOLDER\n"
 			     "\n"
-			     "The -geda, -kicad, -kicadschematic, -gerber SVG options all exit Fritzing after the conversion process is complete;\n"
+			     "The -geda, -kicad, -kicadschematic, -gerber, -mfg, -pastebench, -panbench, -routebench and -svg options all exit Fritzing after the conversion process is complete;\n"
 			     "these options are mutually exclusive.\n"
 			     "\n"
 #ifndef PKGDATADIR
@@ -38,6 +38,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QStyle>
 #include <QFontMetrics>
 #include <QApplication>
+#include <QtConcurrentRun>
 
 
 #include "mainwindow.h"
@@ -57,6 +58,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../items/perfboard.h"
 #include "../items/stripboard.h"
 #include "../items/partfactory.h"
+#include "../svg/svgfragmentcache.h"
 #include "../items/paletteitem.h"
 #include "../items/virtualwire.h"
 #include "../processeventblocker.h"
@@ -243,7 +245,7 @@ int MainWindow::CascadeFactorY = 19;
 static constexpr int MainWindowDefaultWidth = 1024;
 static constexpr int MainWindowDefaultHeight = 768;
 
-int MainWindow::AutosaveTimeoutMinutes = 10;   // in minutes
+int MainWindow::AutosaveTimeoutMinutes = 5;   // in minutes
 bool MainWindow::AutosaveEnabled = true;
 QString MainWindow::BackupFolder;
 
@@ -292,6 +294,7 @@ MainWindow::MainWindow(ReferenceModel *referenceModel, QWidget * parent) :
 	// Add a timer for autosaving
 	m_backingUp = m_autosaveNeeded = false;
 	connect(&m_autosaveTimer, SIGNAL(timeout()), this, SLOT(backupSketch()));
+	connect(&m_backupWatcher, SIGNAL(finished()), this, SLOT(backupSketchFinished()));
 	m_autosaveTimer.start(AutosaveTimeoutMinutes * 60 * 1000);
 
 	resize(MainWindowDefaultWidth, MainWindowDefaultHeight);
@@ -540,6 +543,8 @@ void MainWindow::init(ReferenceModel *referenceModel, bool lockFiles) {
 MainWindow::~MainWindow()
 {
 	// Delete backup of this sketch if one exists.
+	// A background write still in flight would otherwise recreate it.
+	m_backupWatcher.waitForFinished();
 	QFile::remove(m_backupFileNameAndPath);
 
 	delete m_sketchModel;
@@ -562,8 +567,7 @@ MainWindow::~MainWindow()
 void MainWindow::initLockedFiles(bool lockFiles) {
 	LockManager::initLockedFiles("fzz", m_fzzFolder, m_fzzFiles, lockFiles ? LockManager::SlowTime : 0);
 	if (lockFiles) {
-		QFileInfoList backupList;
-		LockManager::checkLockedFiles("fzz", backupList, m_fzzFiles, true, LockManager::SlowTime);
+		LockManager::removeStaleFolders("fzz", true, LockManager::SlowTime);
 	}
 }
 
@@ -2841,6 +2845,11 @@ bool MainWindow::activeLayerWidgetAlwaysOn() {
  * events, such as saves, part imports, file export/printing. This relies
  * on the m_autosaveNeeded variable and the undoStack being dirty for
  * an autosave to be attempted.
+ *
+ * Only the in-memory snapshot of the model is taken on the GUI thread;
+ * writing and syncing the file happens on a worker thread. If a previous
+ * backup is still being written, the request is coalesced and a single
+ * new backup is taken once the running one finishes.
  */
 void  MainWindow::backupSketch() {
 	if (ProcessEventBlocker::isProcessing()) {
@@ -2848,17 +2857,40 @@ void  MainWindow::backupSketch() {
 		return;
 	}
 
+	if (m_backupWatcher.isRunning()) {
+		m_backupPending = true;
+		return;
+	}
+
 	if (m_autosaveNeeded && !m_undoStack->isClean()) {
 		m_autosaveNeeded = false;			// clear this now in case the save takes a really long time
 
 		DebugDialog::debug(QString("%1 autosaved as %2").arg(m_fwFilename).arg(m_backupFileNameAndPath));
 		statusBar()->showMessage(tr("Backing up '%1'").arg(m_fwFilename), 2000);
-		ProcessEventBlocker::processEvents();
 		m_backingUp = true;
 		connectStartSave(true);
-		m_sketchModel->save(m_backupFileNameAndPath, false);
+		QByteArray snapshot = m_sketchModel->snapshot(m_backupFileNameAndPath, false);
 		connectStartSave(false);
 		m_backingUp = false;
+
+		m_backupWatcher.setFuture(QtConcurrent::run(&ModelBase::writeSnapshot, m_backupFileNameAndPath, snapshot));
+	}
+}
+
+void MainWindow::backupSketchFinished() {
+	QString error = m_backupWatcher.result();
+	if (!error.isEmpty()) {
+		DebugDialog::debug(QString("autosave of %1 to %2 failed: %3").arg(m_fwFilename).arg(m_backupFileNameAndPath).arg(error));
+	}
+
+	if (m_undoStack->isClean()) {
+		// the sketch was saved while the backup was being written
+		QFile::remove(m_backupFileNameAndPath);
+	}
+
+	if (m_backupPending) {
+		m_backupPending = false;
+		backupSketch();
 	}
 }
 
@@ -2880,7 +2912,8 @@ void MainWindow::autosaveNeeded(int index) {
  */
 void MainWindow::undoStackCleanChanged(bool isClean) {
 	// DebugDialog::debug(QString("Clean status changed to %1").arg(isClean));
-	if (isClean) {
+	if (isClean && !m_backupWatcher.isRunning()) {
+		// otherwise backupSketchFinished() removes it
 		QFile::remove(m_backupFileNameAndPath);
 	}
 }
@@ -3295,6 +3328,9 @@ bool MainWindow::updateParts(const QString & moduleID, QUndoCommand * parentComm
 		itemBases.insert(itemBase->layerKinChief());
 	}
 
+	// the part was edited and is swapped back in under the same module id
+	SvgFragmentCache::invalidate(moduleID);
+
 	QMap<QString, QString> propsMap;
 	Q_FOREACH (ItemBase * itemBase, itemBases) {
 		swapSelectedAuxAux(itemBase, moduleID, itemBase->viewLayerPlacement(), propsMap, parentCommand);
@@ -40,6 +40,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QPrinter>
 #include <QNetworkAccessManager>
 #include <QShortcut>
+#include <QFutureWatcher>
 
 #include "fritzingwindow.h"
 #include "sketchareawidget.h"
@@ -219,6 +220,11 @@ public:
 	void noSchematicConversion();
 	QString getExportBOM_CSV();
 	QString getSpiceNetlist(QString, QList< QList<class ConnectorItem *>* >&, QSet<class ItemBase *>& );
+	QString getExportNetlist(const QList< QList<class ConnectorItem *>* > & netList);
+	QStringList exportManufacturingFiles(const QString & basePath, const QStringList & formats);
+	QString benchmarkPaste(int repeats);
+	QString benchmarkPan(int frames);
+	QString benchmarkAutoroute();
 	bool isSimulatorEnabled();
 	void enableSimulator(bool);
 	void triggerSimulator();
@@ -427,6 +433,7 @@ protected Q_SLOTS:
 	bool save();
 	bool saveAs();
 	virtual void backupSketch();
+	void backupSketchFinished();
 	void undoStackCleanChanged(bool isClean);
 	void autosaveNeeded(int index = 0);
 	void changeTraceLayer();
@@ -501,7 +508,7 @@ protected:
 	bool eventFilter(QObject *obj, QEvent *event);
 	void setActionsIcons(int index, QList<QAction *> &);
 	void exportToEagle();
-	void exportToGerber();
+	void exportToGerber(bool panelized = false);
 	void exportBOM();
 	void exportBOM_CSV();	
 	void exportNetlist();
@@ -751,6 +758,7 @@ protected:
 	QAction *m_exportPdfAct = nullptr;
 	QAction *m_exportEagleAct = nullptr;
 	QAction *m_exportGerberAct = nullptr;
+	QAction *m_exportGerberPanelAct = nullptr;
 	QAction *m_exportEtchablePdfAct = nullptr;
 	QAction *m_exportEtchableSvgAct = nullptr;
 	QAction *m_exportBomAct = nullptr;
@@ -949,6 +957,8 @@ protected:
 	QTimer m_autosaveTimer;
 	bool m_autosaveNeeded = false;
 	bool m_backingUp = false;
+	bool m_backupPending = false;
+	QFutureWatcher<QString> m_backupWatcher;
 	QString m_bundledSketchName;
 	RoutingStatus m_routingStatus;
 	bool m_orderFabEnabled = false;
@@ -990,8 +1000,10 @@ public:
 	static QString BackupFolder;
 	static const int DockMinWidth;
 	static const int DockMinHeight;
+	static const QStringList ManufacturingFormats;
 
 	QString exportIPC_D_356A();
+	QString exportIPC_D_356A(const QList< QList<class ConnectorItem *>* > & netList);
 protected:
 	static const QString UntitledSketchName;
 	static int UntitledSketchIndex;
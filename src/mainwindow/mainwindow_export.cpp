@@ -37,6 +37,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "connectors/ercdata.h"
 #include "dialogs/exportparametersdialog.h"
+#include "dialogs/gerberpaneldialog.h"
 #include "eagle/fritzing2eagle.h"
 #include "items/partfactory.h"
 #include "infoview/htmlinfoview.h"
@@ -56,6 +57,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 
 static QString eagleActionType = ".eagle";
 static QString gerberActionType = ".gerber";
+static QString gerberPanelActionType = ".gerberpanel";
 static QString jpgActionType = ".jpg";
 static QString pdfActionType = ".pdf";
 static QString pngActionType = ".png";
@@ -75,6 +77,8 @@ static QRegularExpression LabelNumber("([^\\d]+)(.*)");
 
 static constexpr double InchesPerMeter = 39.3700787;
 
+const QStringList MainWindow::ManufacturingFormats = { "bom", "netlist", "spice", "ipc", "pnp" };
+
 ////////////////////////////////////////////////////////
 
 bool sortPartList(ItemBase * b1, ItemBase * b2) {
@@ -491,6 +495,11 @@ void MainWindow::doExport() {
 		return;
 	}
 
+	if (actionType.compare(gerberPanelActionType) == 0) {
+		exportToGerber(true);
+		return;
+	}
+
 	if (actionType.compare(bomActionType) == 0) {
 		exportBOM();
 		return;
@@ -1050,6 +1059,11 @@ void MainWindow::createExportActions() {
 	m_exportGerberAct->setStatusTip(tr("Export the current sketch to Extended Gerber format (RS-274X) for professional PCB production"));
 	connect(m_exportGerberAct, SIGNAL(triggered()), this, SLOT(doExport()));
 
+	m_exportGerberPanelAct = new QAction(tr("Panelized Extended Gerber (RS-274X)..."), this);
+	m_exportGerberPanelAct->setData(gerberPanelActionType);
+	m_exportGerberPanelAct->setStatusTip(tr("Export a step-and-repeat panel of the current board to Extended Gerber format (RS-274X)"));
+	connect(m_exportGerberPanelAct, SIGNAL(triggered()), this, SLOT(doExport()));
+
 	m_exportEtchablePdfAct = new QAction(tr("Etchable (PDF)..."), this);
 	m_exportEtchablePdfAct->setStatusTip(tr("Export the current sketch to PDF for DIY PCB production (photoresist)"));
 	m_exportEtchablePdfAct->setProperty("svg", false);
@@ -1622,11 +1636,6 @@ QString MainWindow::getSpiceNetlist(QString simulationName, QList< QList<class C
 }
 
 QString MainWindow::exportIPC_D_356A() {
-	int boardCount;
-	ItemBase * board = m_pcbGraphicsView->findSelectedBoard(boardCount);
-
-	QString basename = QFileInfo(m_fwFilename).fileName();
-
 	ViewGeometry::WireFlags skipFlags = ViewGeometry::NoFlag;
 	const bool skipBuses = true;
 
@@ -1634,10 +1643,22 @@ QString MainWindow::exportIPC_D_356A() {
 	QList< QList<ConnectorItem *>* > netList;
 	this->m_pcbGraphicsView->collectAllNets(indexer, netList, true, m_pcbGraphicsView->boardLayers() > 1, false, skipFlags, skipBuses);
 
-	QString ipc = getExportIPC_D_356A(board, basename, netList);
+	QString ipc = exportIPC_D_356A(netList);
+	Q_FOREACH (QList<ConnectorItem *> * net, netList) {
+		delete net;
+	}
 	return ipc;
 }
 
+QString MainWindow::exportIPC_D_356A(const QList< QList<ConnectorItem *>* > & netList) {
+	// netList must come from the pcb view with buses skipped: bused pins are not connected on the bare board
+	int boardCount;
+	ItemBase * board = m_pcbGraphicsView->findSelectedBoard(boardCount);
+
+	QString basename = QFileInfo(m_fwFilename).fileName();
+	return getExportIPC_D_356A(board, basename, netList);
+}
+
 void MainWindow::exportIPC_D_356A_interactive() {
 	int boardCount;
 	ItemBase * board = m_pcbGraphicsView->findSelectedBoard(boardCount);
@@ -1673,6 +1694,25 @@ void MainWindow::exportNetlist() {
 	QList< QList<ConnectorItem *>* > netList;
 	this->m_currentGraphicsView->collectAllNets(indexer, netList, true, m_currentGraphicsView->boardLayers() > 1, false);
 
+	QString netlist = getExportNetlist(netList);
+
+	Q_FOREACH (QList<ConnectorItem *> * net, netList) {
+		delete net;
+	}
+	netList.clear();
+
+	save_text_file(
+				netlist,
+				netlistActionType,
+				tr("Export Netlist..."),
+				"netlist",
+				tr("Unable to save netlist file.") + tr("But the content was copied to the clipboard.")
+				);
+
+	return;
+}
+
+QString MainWindow::getExportNetlist(const QList< QList<ConnectorItem *>* > & netList) {
 	QDomDocument doc;
 	doc.setContent(QString("<?xml version='1.0' encoding='UTF-8'?>\n") + TextUtils::CreatedWithFritzingXmlComment);
 	QDomElement netlist = doc.createElement("netlist");
@@ -1680,39 +1720,22 @@ void MainWindow::exportNetlist() {
 	netlist.setAttribute("sketch", QFileInfo(m_fwFilename).fileName());
 	netlist.setAttribute("date", QDateTime::currentDateTime().toString());
 
-	// TODO: filter out 'ignore' connectors
-
-	QList< QList<ConnectorItem *>* > deleteNets;
 	Q_FOREACH (QList<ConnectorItem *> * net, netList) {
-		QList<ConnectorItem *> deleteItems;
+		// leave out 'ignore' connectors; the nets themselves may be shared with other exports, so don't edit them
+		QList<ConnectorItem *> connectorItems;
 		Q_FOREACH (ConnectorItem * connectorItem, *net) {
 			ErcData * ercData = connectorItem->connectorSharedErcData();
-			if (ercData == nullptr) continue;
-
-			if (ercData->ignore() == ErcData::Always) {
-				deleteItems.append(connectorItem);
-			}
-			else if ((ercData->ignore() == ErcData::IfUnconnected) && (net->count() == 1)) {
-				deleteItems.append(connectorItem);
+			if (ercData != nullptr) {
+				if (ercData->ignore() == ErcData::Always) continue;
+				if ((ercData->ignore() == ErcData::IfUnconnected) && (net->count() == 1)) continue;
 			}
+			connectorItems.append(connectorItem);
 		}
+		if (connectorItems.isEmpty()) continue;
 
-		Q_FOREACH (ConnectorItem * connectorItem, deleteItems) {
-			net->removeOne(connectorItem);
-		}
-		if (net->count() == 0) {
-			deleteNets.append(net);
-		}
-	}
-
-	Q_FOREACH (QList<ConnectorItem *> * net, deleteNets) {
-		netList.removeOne(net);
-	}
-
-	Q_FOREACH (QList<ConnectorItem *> * net, netList) {
 		QDomElement netElement = doc.createElement("net");
 		netlist.appendChild(netElement);
-		Q_FOREACH (ConnectorItem * connectorItem, *net) {
+		Q_FOREACH (ConnectorItem * connectorItem, connectorItems) {
 			QDomElement connector = doc.createElement("connector");
 			netElement.appendChild(connector);
 			connector.setAttribute("id", connectorItem->connectorSharedID());
@@ -1733,20 +1756,76 @@ void MainWindow::exportNetlist() {
 		}
 	}
 
-	Q_FOREACH (QList<ConnectorItem *> * net, netList) {
+	return doc.toString();
+}
+
+/**
+ * Write the manufacturing data files for this sketch without any dialogs, for the batch service.
+ *
+ * The netlist keeps bused pins together while IPC-D-356A must not; both come from one walk of the pcb view,
+ * which only walks nets with a part bus a second time. The service opens sketches on the pcb tab, so the netlist
+ * matches an interactive export from there. SPICE keeps its own walk: like the simulator it reads the
+ * schematic scene, with subparts folded into their superparts.
+ * @brief Export manufacturing data files
+ * @param[in] basePath Output path without suffix; each format appends its own
+ * @param[in] formats Any of ManufacturingFormats
+ * @return The formats that could not be written
+ */
+QStringList MainWindow::exportManufacturingFiles(const QString & basePath, const QStringList & formats) {
+	QStringList failed;
+	QFileInfo baseInfo(basePath);
+
+	int boardCount;
+	ItemBase * board = m_pcbGraphicsView->findSelectedBoard(boardCount);
+	if (board == nullptr && (formats.contains("ipc") || formats.contains("pnp"))) {
+		DebugDialog::debug(QString("%1: %2 boards, skipping board exports").arg(m_fwFilename).arg(boardCount));
+	}
+
+	if (formats.contains("bom")) {
+		if (!TextUtils::writeUtf8(basePath + "_bom" + bomCsvActionType, getExportBOM_CSV())) {
+			failed << "bom";
+		}
+	}
+
+	QHash<ConnectorItem *, int> indexer;
+	QList< QList<ConnectorItem *>* > netList;
+	QHash<ConnectorItem *, int> splitIndexer;
+	QList< QList<ConnectorItem *>* > splitNetList;
+	if (formats.contains("netlist") || (formats.contains("ipc") && board != nullptr)) {
+		m_pcbGraphicsView->collectAllNets(indexer, netList, splitIndexer, splitNetList, true, m_pcbGraphicsView->boardLayers() > 1, false);
+	}
+
+	if (formats.contains("netlist")) {
+		if (!TextUtils::writeUtf8(basePath + "_netlist" + netlistActionType, getExportNetlist(netList))) {
+			failed << "netlist";
+		}
+	}
+
+	if (formats.contains("spice")) {
+		if (!TextUtils::writeUtf8(basePath + spiceNetlistActionType, getSpiceNetlist(baseInfo.fileName()))) {
+			failed << "spice";
+		}
+	}
+
+	if (formats.contains("ipc")) {
+		if (board == nullptr) {
+			failed << "ipc";
+		}
+		else if (!TextUtils::writeUtf8(basePath + ipcActionType, getExportIPC_D_356A(board, baseInfo.fileName(), splitNetList))) {
+			failed << "ipc";
+		}
+	}
+	Q_FOREACH (QList<ConnectorItem *> * net, netList + splitNetList) {
 		delete net;
 	}
-	netList.clear();
 
-	save_text_file(
-				doc.toString(),
-				netlistActionType,
-				tr("Export Netlist..."),
-				"netlist",
-				tr("Unable to save netlist file.") + tr("But the content was copied to the clipboard.")
-				);
+	if (formats.contains("pnp")) {
+		if (board == nullptr || !GerberGenerator::exportPickAndPlace(baseInfo.fileName(), baseInfo.absolutePath(), board, m_pcbGraphicsView, false)) {
+			failed << "pnp";
+		}
+	}
 
-	return;
+	return failed;
 }
 
 FileProgressDialog * MainWindow::exportProgress() {
@@ -1788,7 +1867,7 @@ QString MainWindow::getBomProps(ItemBase * itemBase)
 	return pString;
 }
 
-void MainWindow::exportToGerber() {
+void MainWindow::exportToGerber(bool panelized) {
 
 	//NOTE: this assumes just one board per sketch
 
@@ -1807,6 +1886,14 @@ void MainWindow::exportToGerber() {
 		return;
 	}
 
+	GerberPanel panel;
+	if (panelized) {
+		GerberPanelDialog dialog(this);
+		if (dialog.exec() != QDialog::Accepted) return;
+
+		panel = dialog.panel();
+	}
+
 	QString exportDir = QFileDialog::getExistingDirectory(this, tr("Choose a folder for exporting"),
 	                    defaultSaveFolder(),
 	                    QFileDialog::ShowDirsOnly
@@ -1823,7 +1910,10 @@ void MainWindow::exportToGerber() {
 	if (boardCount > 1) {
 		prefix += QString("_%1_%2").arg(board->instanceTitle()).arg(board->id());
 	}
-	GerberGenerator::exportToGerber(prefix, exportDir, board, m_pcbGraphicsView, true);
+	if (panelized) {
+		prefix += QString("_panel%1x%2").arg(panel.columns()).arg(panel.rows());
+	}
+	GerberGenerator::exportToGerber(prefix, exportDir, board, m_pcbGraphicsView, true, panel);
 
 	m_statusBar->showMessage(tr("Sketch exported to Gerber"), 2000);
 
@@ -29,6 +29,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QSettings>
 #include <QDesktopServices>
 #include <QMimeData>
+#include <QElapsedTimer>
 
 #include "mainwindow.h"
 #include "../debugdialog.h"
@@ -43,6 +44,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../items/via.h"
 #include "../items/note.h"
 #include "../items/groundplane.h"
+#include "../svg/svglayercache.h"
 #include "../sketch/breadboardsketchwidget.h"
 #include "../sketch/schematicsketchwidget.h"
 #include "../sketch/pcbsketchwidget.h"
@@ -412,6 +414,9 @@ bool MainWindow::mainLoad(const QString & fileName, const QString & displayName,
 		m_fileProgressDialog->setMessage(tr("loading %1 (breadboard)").arg(displayName2));
 	}
 
+	// split every distinct part svg into its layers up front, in parallel, rather than once per instance
+	SvgLayerCache::prepare(modelParts);
+
 	QList<long> newIDs;
 	m_breadboardGraphicsView->loadFromModelParts(modelParts, BaseCommand::SingleView, nullptr, false, nullptr, false, newIDs);
 
@@ -436,6 +441,7 @@ bool MainWindow::mainLoad(const QString & fileName, const QString & displayName,
 	m_schematicGraphicsView->setOldSchematic(this->m_useOldSchematic);
 	m_schematicGraphicsView->loadFromModelParts(modelParts, BaseCommand::SingleView, nullptr, false, nullptr, false, newIDs);
 	m_schematicGraphicsView->setConvertSchematic(false);
+	SvgLayerCache::clear();
 
 	if (m_sketchModel->checkForReversedWires()) {
 		m_pcbGraphicsView->checkForReversedWires();
@@ -528,10 +534,20 @@ void MainWindow::pasteAux(bool pasteInPlace)
 
 	if (!mimeData->hasFormat("application/x-dnditemsdata")) return;
 
-	QByteArray itemData = mimeData->data("application/x-dnditemsdata");
 	QList<ModelPart *> modelParts;
 	QHash<QString, QRectF> boundingRects;
-	if (m_sketchModel->paste(m_referenceModel, itemData, modelParts, boundingRects, false)) {
+	bool pasted;
+	QDomDocument domDocument;
+	if (SketchWidget::clipboardDocument(mimeData, domDocument)) {
+		// copied within this process: skip reparsing the xml
+		pasted = m_sketchModel->paste(m_referenceModel, domDocument, modelParts, boundingRects, false);
+	}
+	else {
+		QByteArray itemData = mimeData->data("application/x-dnditemsdata");
+		pasted = m_sketchModel->paste(m_referenceModel, itemData, modelParts, boundingRects, false);
+	}
+
+	if (pasted) {
 		auto * parentCommand = new QUndoCommand("Paste"); // if you translate "Paste", you must also do so for the check in sketchwidget.cpp.
 
 		QList<SketchWidget *> sketchWidgets;
@@ -567,6 +583,62 @@ void MainWindow::pasteAux(bool pasteInPlace)
 	m_currentGraphicsView->updateInfoView();
 }
 
+QString MainWindow::benchmarkPaste(int repeats)
+{
+	// developer hook behind -pastebench: copy every part in the current view, then time pasting the copy
+	// through the in-process clipboard document and through the xml; each paste is undone again
+	if (m_currentGraphicsView == nullptr) return QString();
+
+	QClipboard *clipboard = QApplication::clipboard();
+	if (clipboard == nullptr) return QString();
+
+	m_currentGraphicsView->selectAllItems(true, false);
+	int selected = m_currentGraphicsView->scene()->selectedItems().count();
+	m_currentGraphicsView->copy();
+
+	const QMimeData* mimeData = clipboard->mimeData(QClipboard::Clipboard);
+	if (mimeData == nullptr) return QString();
+	if (!mimeData->hasFormat("application/x-dnditemsdata")) return QString();
+
+	QByteArray itemData = mimeData->data("application/x-dnditemsdata");
+
+	auto timePastes = [this, repeats]() {
+		QElapsedTimer elapsedTimer;
+		qint64 total = 0;
+		for (int i = 0; i < repeats; i++) {
+			elapsedTimer.start();
+			pasteAux(false);
+			total += elapsedTimer.elapsed();
+			m_undoStack->undo();
+		}
+		return total;
+	};
+
+	qint64 inProcess = timePastes();
+
+	// the same bytes without the clipboard id take the path used for a copy from another process
+	auto *xmlMimeData = new QMimeData;
+	xmlMimeData->setData("application/x-dnditemsdata", itemData);
+	clipboard->setMimeData(xmlMimeData, QClipboard::Clipboard);
+
+	qint64 xml = timePastes();
+
+	return QString("%1: %2 items, %3 bytes, %4 pastes: in-process %5 ms, xml %6 ms")
+	       .arg(m_currentGraphicsView->viewName())
+	       .arg(selected)
+	       .arg(itemData.size())
+	       .arg(repeats)
+	       .arg(inProcess)
+	       .arg(xml);
+}
+
+QString MainWindow::benchmarkPan(int frames)
+{
+	if (m_currentGraphicsView == nullptr) return QString();
+
+	return m_currentGraphicsView->benchmarkPan(frames);
+}
+
 void MainWindow::duplicate() {
 	if (m_currentGraphicsView == nullptr) return;
 
@@ -1462,6 +1534,7 @@ void MainWindow::populateExportMenu() {
 	productionMenu->addAction(m_exportEtchableSvgAct);
 	productionMenu->addSeparator();
 	productionMenu->addAction(m_exportGerberAct);
+	productionMenu->addAction(m_exportGerberPanelAct);
 }
 
 
@@ -3085,6 +3158,55 @@ void MainWindow::newAutoroute() {
 	Q_EMIT pcbSketchWidget->routingStatusSignal(pcbSketchWidget, routingStatus);
 }
 
+QString MainWindow::benchmarkAutoroute()
+{
+	// developer hook behind -routebench: autoroute the board once in ordering and once in negotiated mode,
+	// undoing each run, and report the nets routed and the wall time of both
+	auto * pcbSketchWidget = qobject_cast<PCBSketchWidget *>(m_pcbGraphicsView);
+	if (pcbSketchWidget == nullptr) return QString();
+
+	int boardCount;
+	ItemBase * board = pcbSketchWidget->findSelectedBoard(boardCount);
+	if (board == nullptr) return QString();
+
+	QHash<QString, QString> original = pcbSketchWidget->getAutorouterSettings();
+	QStringList results;
+	QStringList modes;
+	modes << "false" << "true";
+	Q_FOREACH (QString negotiated, modes) {
+		QHash<QString, QString> settings(original);
+		settings.insert(Autorouter::NegotiatedName, negotiated);
+		pcbSketchWidget->setAutorouterSettings(settings);
+
+		int undoIndex = m_undoStack->index();
+		QElapsedTimer elapsedTimer;
+		elapsedTimer.start();
+		ProcessEventBlocker::block();
+		auto * autorouter = new MazeRouter(pcbSketchWidget, board, true);
+		autorouter->start();
+		delete autorouter;
+		ProcessEventBlocker::unblock();
+		qint64 elapsed = elapsedTimer.elapsed();
+
+		RoutingStatus routingStatus;
+		routingStatus.zero();
+		pcbSketchWidget->updateRoutingStatus(routingStatus, true);
+		results << QString("%1 %2 of %3 nets routed, %4 jumpers, %5 ms")
+		        .arg(negotiated == "true" ? "negotiated" : "ordering")
+		        .arg(routingStatus.m_netRoutedCount)
+		        .arg(routingStatus.m_netCount)
+		        .arg(routingStatus.m_jumperItemCount)
+		        .arg(elapsed);
+
+		while (m_undoStack->index() > undoIndex) {
+			m_undoStack->undo();
+		}
+	}
+
+	pcbSketchWidget->setAutorouterSettings(original);
+	return results.join("; ");
+}
+
 void MainWindow::createTrace() {
 	m_currentGraphicsView->createTrace(retrieveWire(), true);
 }
@@ -29,6 +29,8 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../viewgeometry.h"
 
 #include <QMessageBox>
+#include <QBuffer>
+#include <QSaveFile>
 
 QList<QString> ModelBase::CoreList;
 
@@ -201,55 +203,43 @@ bool ModelBase::loadFromFile(const QString & fileName, ModelBase * referenceMode
 
 	Q_EMIT loadingInstances(this, instances);
 
-	if (checkForRats) {
+	// run all the legacy checks in a single pass over the instances
+	m_useOldSchematics = false;
+	bool foundObsoleteSMDOrientation = false;
+	bool foundOldSchematics = false;
+	if (checkForRats || checkForTraces || checkForMysteryParts || checkForObsoleteSMDOrientation || checkForOldSchematics) {
 		QDomElement instance = instances.firstChildElement("instance");
 		while (!instance.isNull()) {
 			QDomElement nextInstance = instance.nextSiblingElement("instance");
-			if (isRatsnest(instance)) {
+			if (checkForRats && isRatsnest(instance)) {
 				instances.removeChild(instance);
+				instance = nextInstance;
+				continue;
 			}
 
-			instance = nextInstance;
-		}
-	}
-
-	if (checkForTraces) {
-		QDomElement instance = instances.firstChildElement("instance");
-		while (!instance.isNull()) {
-			checkTraces(instance);
-			instance = instance.nextSiblingElement("instance");
-		}
-	}
+			if (checkForTraces) {
+				checkTraces(instance);
+			}
+			if (checkForMysteryParts) {
+				checkMystery(instance);
+			}
+			if (checkForObsoleteSMDOrientation && !foundObsoleteSMDOrientation) {
+				foundObsoleteSMDOrientation = checkObsoleteOrientation(instance);
+			}
+			if (checkForOldSchematics && !foundOldSchematics) {
+				foundOldSchematics = checkOldSchematics(instance);
+			}
 
-	if (checkForMysteryParts) {
-		QDomElement instance = instances.firstChildElement("instance");
-		while (!instance.isNull()) {
-			checkMystery(instance);
-			instance = instance.nextSiblingElement("instance");
+			instance = nextInstance;
 		}
 	}
 
-	if (checkForObsoleteSMDOrientation) {
-		QDomElement instance = instances.firstChildElement("instance");
-		while (!instance.isNull()) {
-			if (checkObsoleteOrientation(instance)) {
-				Q_EMIT obsoleteSMDOrientationSignal();
-				break;
-			}
-			instance = instance.nextSiblingElement("instance");
-		}
+	if (foundObsoleteSMDOrientation) {
+		Q_EMIT obsoleteSMDOrientationSignal();
 	}
 
-	m_useOldSchematics = false;
-	if (checkForOldSchematics) {
-		QDomElement instance = instances.firstChildElement("instance");
-		while (!instance.isNull()) {
-			if (checkOldSchematics(instance)) {
-				Q_EMIT oldSchematicsSignal(fileName, m_useOldSchematics);
-				break;
-			}
-			instance = instance.nextSiblingElement("instance");
-		}
+	if (foundOldSchematics) {
+		Q_EMIT oldSchematicsSignal(fileName, m_useOldSchematics);
 	}
 
 	bool result = loadInstances(domDocument, instances, modelParts, checkViews);
@@ -492,10 +482,47 @@ void ModelBase::save(const QString & fileName, QXmlStreamWriter & streamWriter,
 	}
 }
 
+/**
+ * Serialize the model into memory. This is the only part of a backup which
+ * has to run on the GUI thread, since it walks the live model.
+ */
+QByteArray ModelBase::snapshot(const QString & fileName, bool asPart) {
+	QByteArray data;
+	QBuffer buffer(&data);
+	buffer.open(QIODevice::WriteOnly | QIODevice::Text);
+	QXmlStreamWriter streamWriter(&buffer);
+	save(fileName, streamWriter, asPart);
+	buffer.close();
+	return data;
+}
+
+/**
+ * Write a snapshot produced by snapshot() to disk. Safe to call from a worker
+ * thread: it touches no model or GUI state. The file is replaced atomically and
+ * synced to disk before the rename. Returns an error message, or an empty string
+ * on success.
+ */
+QString ModelBase::writeSnapshot(const QString & fileName, const QByteArray & snapshot) {
+	QSaveFile file(fileName);
+	if (!file.open(QIODevice::WriteOnly)) {
+		return file.errorString();
+	}
+
+	if (file.write(snapshot) != snapshot.size()) {
+		QString error = file.errorString();
+		file.cancelWriting();
+		return error;
+	}
+
+	if (!file.commit()) {
+		return file.errorString();
+	}
+
+	return QString();
+}
+
 bool ModelBase::paste(ModelBase * referenceModel, QByteArray & data, QList<ModelPart *> & modelParts, QHash<QString, QRectF> & boundingRects, bool preserveIndex)
 {
-	m_referenceModel = referenceModel;
-
 	QDomDocument domDocument;
 	QString errorStr;
 	int errorLine;
@@ -503,6 +530,13 @@ bool ModelBase::paste(ModelBase * referenceModel, QByteArray & data, QList<Model
 	bool result = domDocument.setContent(data, &errorStr, &errorLine, &errorColumn);
 	if (!result) return false;
 
+	return paste(referenceModel, domDocument, modelParts, boundingRects, preserveIndex);
+}
+
+bool ModelBase::paste(ModelBase * referenceModel, QDomDocument & domDocument, QList<ModelPart *> & modelParts, QHash<QString, QRectF> & boundingRects, bool preserveIndex)
+{
+	m_referenceModel = referenceModel;
+
 	QDomElement module = domDocument.documentElement();
 	if (module.isNull()) {
 		return false;
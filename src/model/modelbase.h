@@ -39,10 +39,12 @@ public:
 	bool loadFromFile(const QString & fileName, ModelBase* referenceModel, QList<ModelPart *> & modelParts, bool checkInstances);
 	bool save(const QString & fileName, bool asPart);
 	void save(const QString & fileName, class QXmlStreamWriter &, bool asPart);
+	QByteArray snapshot(const QString & fileName, bool asPart);
 	virtual ModelPart * addPart(QString newPartPath, bool addToReference);
 	virtual bool addPart(ModelPart * modelPart, bool update);
 	virtual ModelPart * addPart(QString newPartPath, bool addToReference, bool updateIdAlreadyExists);
 	bool paste(ModelBase * referenceModel, QByteArray & data, QList<ModelPart *> & modelParts, QHash<QString, QRectF> & boundingRects, bool preserveIndex);
+	bool paste(ModelBase * referenceModel, QDomDocument &, QList<ModelPart *> & modelParts, QHash<QString, QRectF> & boundingRects, bool preserveIndex);
 	void setReportMissingModules(bool);
 	ModelPart * genFZP(const QString & moduleID, ModelBase * referenceModel);
 	const QString & fritzingVersion();
@@ -51,6 +53,7 @@ public:
 
 public:
 	static bool onCoreList(const QString & moduleID);
+	static QString writeSnapshot(const QString & fileName, const QByteArray & snapshot);
 
 Q_SIGNALS:
 	void loadedViews(ModelBase *, QDomElement & views);
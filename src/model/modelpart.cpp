@@ -61,6 +61,14 @@ ModelPart::ModelPart(QDomDocument & domDocument, const QString & path, ItemType
 	m_modelPartShared->addOwner(this);
 }
 
+ModelPart::ModelPart(ModelPartShared * modelPartShared, ItemType type)
+	: QObject()
+{
+	commonInit(type);
+	m_modelPartShared = modelPartShared;
+	m_modelPartShared->addOwner(this);
+}
+
 void ModelPart::commonInit(ItemType type) {
 	m_type = type;
 	m_locationFlags = QFlags<LocationFlag>();
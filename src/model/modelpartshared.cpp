@@ -200,6 +200,35 @@ bool ModelPartShared::setDomDocument(QDomDocument & domDocument) {
 	return true;
 }
 
+void ModelPartShared::writeFields(QDataStream & stream) const {
+	// everything setDomDocument() reads from the fzp, so a part can be restored without parsing it again
+	stream << m_title << m_label << m_version << m_author << m_description << m_url << m_taxonomy << m_date << m_replacedby;
+	stream << m_spice << m_spiceModel << m_tags << m_properties << m_displayKeys << m_moduleID << m_fritzingVersion;
+
+	stream << static_cast<qint32>(m_viewImages.count());
+	Q_FOREACH (ViewImage * viewImage, m_viewImages) {
+		stream << static_cast<qint32>(viewImage->viewID) << viewImage->layers << viewImage->sticky << viewImage->image
+		       << viewImage->canFlipHorizontal << viewImage->canFlipVertical;
+	}
+}
+
+bool ModelPartShared::readFields(QDataStream & stream) {
+	stream >> m_title >> m_label >> m_version >> m_author >> m_description >> m_url >> m_taxonomy >> m_date >> m_replacedby;
+	stream >> m_spice >> m_spiceModel >> m_tags >> m_properties >> m_displayKeys >> m_moduleID >> m_fritzingVersion;
+
+	qint32 count = 0;
+	stream >> count;
+	for (int i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+		qint32 viewID = 0;
+		stream >> viewID;
+		auto * viewImage = new ViewImage(static_cast<ViewLayer::ViewID>(viewID));
+		stream >> viewImage->layers >> viewImage->sticky >> viewImage->image >> viewImage->canFlipHorizontal >> viewImage->canFlipVertical;
+		m_viewImages.insert(viewImage->viewID, viewImage);
+	}
+
+	return stream.status() == QDataStream::Ok && !m_moduleID.isEmpty();
+}
+
 void ModelPartShared::loadTagText(QDomElement parent, QString tagName, QString &field) {
 	QDomElement tagElement = parent.firstChildElement(tagName);
 	if (!tagElement.isNull()) {
@@ -28,6 +28,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QHash>
 #include <QDate>
 #include <QPointer>
+#include <QDataStream>
 
 #include "../viewlayer.h"
 
@@ -147,6 +148,8 @@ public:
 	void addOwner(QObject *);
 	void setSubpartOffset(QPointF);
 	QPointF subpartOffset() const;
+	void writeFields(QDataStream &) const;
+	bool readFields(QDataStream &);
 
 protected:
 	void loadTagText(QDomElement parent, QString tagName, QString &field);
@@ -24,8 +24,11 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QApplication>
 #include <QDir>
 #include <QDomElement>
+#include <QtConcurrentMap>
 
 #include "modelpart.h"
+#include "modelpartshared.h"
+#include "partsmanifest.h"
 #include "../utils/folderutils.h"
 #include "../utils/fmessagebox.h"
 #include "../utils/textutils.h"
@@ -108,68 +111,75 @@ void PaletteModel::loadParts(bool dbExists) {
 	QStringList nameFilters;
 	nameFilters << "*" + FritzingPartExtension;
 
-	int totalPartCount = 0;
-	Q_EMIT loadedPart(0, totalPartCount);
+	Q_EMIT loadedPart(0, 0);
 
 	QDir dir1 = FolderUtils::getAppPartsSubFolder("");
 	QDir dir2(FolderUtils::getUserPartsPath());
 	QDir dir3(":/resources/parts");
 	QDir dir4(s_fzpOverrideFolder);
 
+	// one walk collects every fzp in load order; parsing then runs on the thread pool
+	QList<FzpLoad> loads;
 	if (m_fullLoad || !dbExists) {
 		// otherwise these will already be in the database
-		countParts(dir1, nameFilters, totalPartCount);
-		countParts(dir3, nameFilters, totalPartCount);
+		collectParts(dir1, nameFilters, false, loads);
+		collectParts(dir3, nameFilters, false, loads);
 	}
 
 	if (!m_fullLoad) {
 		// don't include local parts when doing full load
-		countParts(dir2, nameFilters, totalPartCount);
+		collectParts(dir2, nameFilters, true, loads);
 		if (!s_fzpOverrideFolder.isEmpty()) {
-			countParts(dir4, nameFilters, totalPartCount);
+			collectParts(dir4, nameFilters, false, loads);
 		}
 	}
 
-	Q_EMIT partsToLoad(totalPartCount);
+	Q_EMIT partsToLoad(loads.count());
 
-	int loadingPart = 0;
-	if (m_fullLoad || !dbExists) {
-		// otherwise these will already be in the database
-		loadPartsAux(dir1, nameFilters, loadingPart, totalPartCount);
-		loadPartsAux(dir3, nameFilters, loadingPart, totalPartCount);
-	}
+	PartsManifest manifest(PartsManifest::defaultFilename());
+	manifest.load();
 
-	if (!m_fullLoad) {
-		loadPartsAux(dir2, nameFilters, loadingPart, totalPartCount);
-		if (!s_fzpOverrideFolder.isEmpty()) {
-			loadPartsAux(dir4, nameFilters, loadingPart, totalPartCount);
+	// register in batches so the splash screen progress keeps moving
+	static constexpr int BatchSize = 256;
+	int loadingPart = 0;
+	for (int batchStart = 0; batchStart < loads.count(); batchStart += BatchSize) {
+		QList<FzpLoad *> batch;
+		for (int i = batchStart; i < qMin(batchStart + BatchSize, loads.count()); i++) {
+			batch.append(&loads[i]);
 		}
-	}
-}
 
-void PaletteModel::countParts(QDir & dir, QStringList & nameFilters, int & partCount) {
-	QStringList list = dir.entryList(nameFilters, QDir::Files | QDir::NoSymLinks);
-	partCount += list.size();
+		QtConcurrent::blockingMap(batch, [&manifest](FzpLoad * load) {
+			readFzp(*load, load->userPart ? &manifest : nullptr);
+		});
 
-	QStringList dirs = dir.entryList(QDir::AllDirs | QDir::NoSymLinks | QDir::NoDotAndDotDot);
-	for (int i = 0; i < dirs.size(); ++i) {
-		QString temp2 = dirs[i];
-		dir.cd(temp2);
+		Q_FOREACH (FzpLoad * load, batch) {
+			m_loadingContrib = load->contrib;
+			registerPart(*load, false);
+			if (load->userPart) {
+				if (load->fromManifest) {
+					manifest.keep(load->path);
+				}
+				else if (!load->manifestFields.isEmpty()) {
+					manifest.insert(QFileInfo(load->path), load->type, load->manifestFields);
+				}
+			}
+			Q_EMIT loadedPart(++loadingPart, loads.count());
+		}
+	}
 
-		countParts(dir, nameFilters, partCount);
-		dir.cdUp();
+	if (!m_fullLoad) {
+		manifest.save();
 	}
 }
 
-void PaletteModel::loadPartsAux(QDir & dir, QStringList & nameFilters, int & loadingPart, int totalPartCount) {
-	//QString temp = dir.absolutePath();
+void PaletteModel::collectParts(QDir & dir, QStringList & nameFilters, bool userParts, QList<FzpLoad> & loads) {
 	QFileInfoList list = dir.entryInfoList(nameFilters, QDir::Files | QDir::NoSymLinks);
 	for (auto fileInfo : list) {
-			QString path = fileInfo.absoluteFilePath ();
-		//DebugDialog::debug(QString("part path:%1 core? %2").arg(path).arg(m_loadingCore? "true" : "false"));
-		PaletteModel::loadPart(path, false);
-		Q_EMIT loadedPart(++loadingPart, totalPartCount);
-		//DebugDialog::debug("loadedok");
+		FzpLoad load;
+		load.path = fileInfo.absoluteFilePath();
+		load.contrib = m_loadingContrib;
+		load.userPart = userParts;
+		loads.append(load);
 	}
 
 	QStringList dirs = dir.entryList(QDir::AllDirs | QDir::NoSymLinks | QDir::NoDotAndDotDot);
@@ -179,137 +189,179 @@ void PaletteModel::loadPartsAux(QDir & dir, QStringList & nameFilters, int & loa
 
 		m_loadingContrib = (temp2 == "contrib");
 
-		loadPartsAux(dir, nameFilters, loadingPart, totalPartCount);
+		collectParts(dir, nameFilters, userParts, loads);
 		dir.cdUp();
 	}
 }
 
-ModelPart * PaletteModel::loadPart(const QString & path, bool update) {
-
-	QFile file(path);
-	if (!file.open(QFile::ReadOnly | QFile::Text)) {
-		FMessageBox::warning(nullptr, QObject::tr("Fritzing"),
-		                     QObject::tr("Cannot read file %1:\n%2.")
-		                     .arg(path)
-		                     .arg(file.errorString()));
-		return nullptr;
-	}
-
-	//DebugDialog::debug(QString("loading %2 %1").arg(path).arg(QTime::currentTime().toString("HH:mm:ss.zzz")));
-
-	ModelPart::ItemType type = ModelPart::Part;
-	QString moduleID;
-	QString title;
-	QString propertiesText;
-
-	QString errorStr;
-	int errorLine;
-	int errorColumn;
-	QDomDocument domDocument;
-	if (!domDocument.setContent(&file, true, &errorStr, &errorLine, &errorColumn)) {
-		FMessageBox::information(nullptr, QObject::tr("Fritzing"),
-		                         QObject::tr("Parse error (2) at line %1, column %2:\n%3\n%4")
-		                         .arg(errorLine)
-		                         .arg(errorColumn)
-		                         .arg(errorStr)
-		                         .arg(path));
-		return nullptr;
-	}
-
-	QDomElement root = domDocument.documentElement();
-	if (root.isNull()) {
-		//QMessageBox::information(NULL, QObject::tr("Fritzing"), QObject::tr("The file is not a Fritzing file (8)."));
-		return nullptr;
-	}
-
-	if (root.tagName() != "module") {
-		//QMessageBox::information(NULL, QObject::tr("Fritzing"), QObject::tr("The file is not a Fritzing file (9)."));
-		return nullptr;
-	}
-
-	moduleID = root.attribute("moduleId");
-	if (moduleID.isNull() || moduleID.isEmpty()) {
-		//QMessageBox::information(NULL, QObject::tr("Fritzing"), QObject::tr("The file is not a Fritzing file (10)."));
-		return nullptr;
-	}
+ModelPart::ItemType PaletteModel::partType(const QDomElement & root) {
+	QString moduleID = root.attribute("moduleId");
 
 	// check if it's a wire
 	QDomElement propertiesElement = root.firstChildElement("properties");
-	propertiesText = propertiesElement.text();
+	QString propertiesText = propertiesElement.text();
 
+	QString title;
 	QDomElement t = root.firstChildElement("title");
 	TextUtils::findText(t, title);
 
-	//DebugDialog::debug("module ID " + moduleID);
-
 	// FIXME: properties is nested right now
 	if (moduleID.compare(ModuleIDNames::WireModuleIDName) == 0) {
-		type = ModelPart::Wire;
+		return ModelPart::Wire;
 	}
-	else if (moduleID.compare(ModuleIDNames::JumperModuleIDName) == 0) {
-		type = ModelPart::Jumper;
+	if (moduleID.compare(ModuleIDNames::JumperModuleIDName) == 0) {
+		return ModelPart::Jumper;
 	}
-	else if (moduleID.endsWith(ModuleIDNames::LogoImageModuleIDName)) {
-		type = ModelPart::Logo;
+	if (moduleID.endsWith(ModuleIDNames::LogoImageModuleIDName)) {
+		return ModelPart::Logo;
 	}
-	else if (moduleID.endsWith(ModuleIDNames::LogoTextModuleIDName)) {
-		type = ModelPart::Logo;
+	if (moduleID.endsWith(ModuleIDNames::LogoTextModuleIDName)) {
+		return ModelPart::Logo;
 	}
-	else if (moduleID.compare(ModuleIDNames::GroundPlaneModuleIDName) == 0) {
-		type = ModelPart::CopperFill;
+	if (moduleID.compare(ModuleIDNames::GroundPlaneModuleIDName) == 0) {
+		return ModelPart::CopperFill;
 	}
-	else if (moduleID.compare(ModuleIDNames::NoteModuleIDName) == 0) {
-		type = ModelPart::Note;
+	if (moduleID.compare(ModuleIDNames::NoteModuleIDName) == 0) {
+		return ModelPart::Note;
 	}
-	else if (moduleID.endsWith(ModuleIDNames::TwoPowerModuleIDName)) {
-		type = ModelPart::Part;
+	if (moduleID.endsWith(ModuleIDNames::TwoPowerModuleIDName)) {
+		return ModelPart::Part;
 	}
-	else if (moduleID.endsWith(ModuleIDNames::PowerModuleIDName)) {
-		type = ModelPart::Symbol;
+	if (moduleID.endsWith(ModuleIDNames::PowerModuleIDName)) {
+		return ModelPart::Symbol;
 	}
-	else if (moduleID.compare(ModuleIDNames::GroundModuleIDName) == 0) {
-		type = ModelPart::Symbol;
+	if (moduleID.compare(ModuleIDNames::GroundModuleIDName) == 0) {
+		return ModelPart::Symbol;
 	}
-	else if (moduleID.endsWith(ModuleIDNames::NetLabelModuleIDName)) {
-		type = ModelPart::Symbol;
+	if (moduleID.endsWith(ModuleIDNames::NetLabelModuleIDName)) {
+		return ModelPart::Symbol;
 	}
-	else if (moduleID.compare(ModuleIDNames::PowerLabelModuleIDName) == 0) {
-		type = ModelPart::Symbol;
+	if (moduleID.compare(ModuleIDNames::PowerLabelModuleIDName) == 0) {
+		return ModelPart::Symbol;
 	}
-	else if (moduleID.compare(ModuleIDNames::RulerModuleIDName) == 0) {
-		type = ModelPart::Ruler;
+	if (moduleID.compare(ModuleIDNames::RulerModuleIDName) == 0) {
+		return ModelPart::Ruler;
 	}
-	else if (moduleID.compare(ModuleIDNames::ViaModuleIDName) == 0) {
-		type = ModelPart::Via;
+	if (moduleID.compare(ModuleIDNames::ViaModuleIDName) == 0) {
+		return ModelPart::Via;
 	}
-	else if (moduleID.compare(ModuleIDNames::HoleModuleIDName) == 0) {
-		type = ModelPart::Hole;
+	if (moduleID.compare(ModuleIDNames::HoleModuleIDName) == 0) {
+		return ModelPart::Hole;
 	}
-	else if (moduleID.endsWith(ModuleIDNames::PerfboardModuleIDName)) {
-		type = ModelPart::Breadboard;
+	if (moduleID.endsWith(ModuleIDNames::PerfboardModuleIDName)) {
+		return ModelPart::Breadboard;
 	}
-	else if (moduleID.endsWith(ModuleIDNames::StripboardModuleIDName)) {
-		type = ModelPart::Breadboard;
+	if (moduleID.endsWith(ModuleIDNames::StripboardModuleIDName)) {
+		return ModelPart::Breadboard;
 	}
-	else if (moduleID.endsWith(ModuleIDNames::Stripboard2ModuleIDName)) {
-		type = ModelPart::Breadboard;
+	if (moduleID.endsWith(ModuleIDNames::Stripboard2ModuleIDName)) {
+		return ModelPart::Breadboard;
 	}
-	else if (propertiesText.contains("breadboard", Qt::CaseInsensitive)) {
-		type = ModelPart::Breadboard;
+	if (propertiesText.contains("breadboard", Qt::CaseInsensitive)) {
+		return ModelPart::Breadboard;
 	}
-	else if (propertiesText.contains("plain vanilla pcb", Qt::CaseInsensitive)) {
+	if (propertiesText.contains("plain vanilla pcb", Qt::CaseInsensitive)) {
 		if (propertiesText.contains("shield", Qt::CaseInsensitive) || title.contains("custom", Qt::CaseInsensitive)) {
-			type = ModelPart::Board;
+			return ModelPart::Board;
 		}
-		else {
-			type = ModelPart::ResizableBoard;
+
+		return ModelPart::ResizableBoard;
+	}
+
+	return ModelPart::Part;
+}
+
+void PaletteModel::readFzp(FzpLoad & load, const PartsManifest * manifest) {
+	// runs on worker threads: nothing here may touch the model or show a message
+
+	if (manifest) {
+		int type = ModelPart::Part;
+		QByteArray fields;
+		if (manifest->find(QFileInfo(load.path), type, fields)) {
+			auto * modelPartShared = new ModelPartShared();
+			QDataStream stream(fields);
+			if (modelPartShared->readFields(stream)) {
+				modelPartShared->setPath(load.path);
+				modelPartShared->moveToThread(QCoreApplication::instance()->thread());
+				load.modelPartShared = modelPartShared;
+				load.type = static_cast<ModelPart::ItemType>(type);
+				load.fromManifest = true;
+				return;
+			}
+
+			delete modelPartShared;
 		}
 	}
 
-	auto * modelPart = new ModelPart(domDocument, path, type);
-	if (!modelPart) return nullptr;
+	QFile file(load.path);
+	if (!file.open(QFile::ReadOnly | QFile::Text)) {
+		load.readError = file.errorString();
+		return;
+	}
+
+	//DebugDialog::debug(QString("loading %2 %1").arg(path).arg(QTime::currentTime().toString("HH:mm:ss.zzz")));
+
+	if (!load.domDocument.setContent(&file, true, &load.parseError, &load.parseErrorLine, &load.parseErrorColumn)) {
+		load.parseFailed = true;
+		return;
+	}
 
-	if (path.startsWith(ResourcePath)) {
+	QDomElement root = load.domDocument.documentElement();
+	if (root.isNull()) {
+		//QMessageBox::information(NULL, QObject::tr("Fritzing"), QObject::tr("The file is not a Fritzing file (8)."));
+		return;
+	}
+
+	if (root.tagName() != "module") {
+		//QMessageBox::information(NULL, QObject::tr("Fritzing"), QObject::tr("The file is not a Fritzing file (9)."));
+		return;
+	}
+
+	QString moduleID = root.attribute("moduleId");
+	if (moduleID.isNull() || moduleID.isEmpty()) {
+		//QMessageBox::information(NULL, QObject::tr("Fritzing"), QObject::tr("The file is not a Fritzing file (10)."));
+		return;
+	}
+
+	//DebugDialog::debug("module ID " + moduleID);
+
+	load.type = partType(root);
+	load.modelPartShared = new ModelPartShared(load.domDocument, load.path);
+	load.modelPartShared->moveToThread(QCoreApplication::instance()->thread());
+
+	if (manifest && root.firstChildElement("schematic-subparts").firstChildElement("subpart").isNull()) {
+		// subparts are built from the superpart's document, so those parts are always parsed
+		QDataStream stream(&load.manifestFields, QIODevice::WriteOnly);
+		load.modelPartShared->writeFields(stream);
+	}
+}
+
+ModelPart * PaletteModel::registerPart(FzpLoad & load, bool update) {
+	if (!load.readError.isNull()) {
+		FMessageBox::warning(nullptr, QObject::tr("Fritzing"),
+		                     QObject::tr("Cannot read file %1:\n%2.")
+		                     .arg(load.path)
+		                     .arg(load.readError));
+		return nullptr;
+	}
+
+	if (load.parseFailed) {
+		FMessageBox::information(nullptr, QObject::tr("Fritzing"),
+		                         QObject::tr("Parse error (2) at line %1, column %2:\n%3\n%4")
+		                         .arg(load.parseErrorLine)
+		                         .arg(load.parseErrorColumn)
+		                         .arg(load.parseError)
+		                         .arg(load.path));
+		return nullptr;
+	}
+
+	if (load.modelPartShared == nullptr) return nullptr;
+
+	auto * modelPart = new ModelPart(load.modelPartShared, load.type);
+	load.modelPartShared = nullptr;
+	QString moduleID = modelPart->moduleID();
+
+	if (load.path.startsWith(ResourcePath)) {
 		modelPart->setCore(true);
 	}
 	else if (onCoreList(moduleID)) {
@@ -319,10 +371,10 @@ ModelPart * PaletteModel::loadPart(const QString & path, bool update) {
 
 	modelPart->setContrib(m_loadingContrib);
 
-	QDomElement subparts = root.firstChildElement("schematic-subparts");
+	QDomElement subparts = load.domDocument.documentElement().firstChildElement("schematic-subparts");
 	QDomElement subpart = subparts.firstChildElement("subpart");
 	while (!subpart.isNull()) {
-		ModelPart * subModelPart = makeSubpart(modelPart, subpart.attribute("id"), domDocument);
+		ModelPart * subModelPart = makeSubpart(modelPart, subpart.attribute("id"), load.domDocument);
 		m_partHash.insert(subModelPart->moduleID(), subModelPart);
 		subpart = subpart.nextSiblingElement("subpart");
 	}
@@ -332,7 +384,7 @@ ModelPart * PaletteModel::loadPart(const QString & path, bool update) {
 			FMessageBox::warning(nullptr, QObject::tr("Fritzing"),
 			                     QObject::tr("The part '%1' at '%2' does not have a unique module id '%3'.")
 			                     .arg(modelPart->title())
-			                     .arg(path)
+			                     .arg(load.path)
 			                     .arg(moduleID));
 			return nullptr;
 		} else {
@@ -352,6 +404,13 @@ ModelPart * PaletteModel::loadPart(const QString & path, bool update) {
 	return modelPart;
 }
 
+ModelPart * PaletteModel::loadPart(const QString & path, bool update) {
+	FzpLoad load;
+	load.path = path;
+	readFzp(load, nullptr);
+	return registerPart(load, update);
+}
+
 bool PaletteModel::loadFromFile(const QString & fileName, ModelBase * referenceModel, bool checkViews) {
 	QList<ModelPart *> modelParts;
 	bool result = ModelBase::loadFromFile(fileName, referenceModel, modelParts, checkViews);
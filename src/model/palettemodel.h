@@ -30,6 +30,24 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QStringList>
 #include <QHash>
 
+class PartsManifest;
+
+struct FzpLoad {
+	QString path;
+	bool contrib = false;
+	bool userPart = false;
+	bool fromManifest = false;
+	QDomDocument domDocument;
+	ModelPartShared * modelPartShared = nullptr;
+	ModelPart::ItemType type = ModelPart::Part;
+	QByteArray manifestFields;  // to record in the user parts manifest
+	QString readError;
+	bool parseFailed = false;
+	QString parseError;
+	int parseErrorLine = 0;
+	int parseErrorColumn = 0;
+};
+
 class PaletteModel : public ModelBase
 {
 	Q_OBJECT
@@ -72,8 +90,8 @@ Q_SIGNALS:
 protected:
 	virtual void initParts(bool dbExists);
 	void loadParts(bool dbExists);
-	void loadPartsAux(QDir & dir, QStringList & nameFilters, int & loadedPart, int totalParts);
-	void countParts(QDir & dir, QStringList & nameFilters, int & partCount);
+	void collectParts(QDir & dir, QStringList & nameFilters, bool userParts, QList<FzpLoad> & loads);
+	ModelPart * registerPart(FzpLoad &, bool update);
 	ModelPart * makeSubpart(ModelPart * originalModelPart, const QString & newSubID, const QDomDocument & superpartDoc);
 
 public:
@@ -81,6 +99,8 @@ public:
 	static QDomDocument makeSubpartDoc(const QString & newSubID, const QDomDocument & superpartDoc);
 	static void initNames();
 	static void setFzpOverrideFolder(const QString &);
+	static ModelPart::ItemType partType(const QDomElement & root);
+	static void readFzp(FzpLoad &, const PartsManifest *);
 
 protected:
 	static QString s_fzpOverrideFolder;
@@ -0,0 +1,137 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+
+#include "partsmanifest.h"
+#include "../debugdialog.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+static constexpr quint32 ManifestMagic = 0x465a504d;  // "FZPM"
+static constexpr qint32 ManifestVersion = 1;  // bump when ModelPartShared::writeFields changes
+
+PartsManifest::PartsManifest(const QString & filename) : m_filename(filename)
+{
+}
+
+QString PartsManifest::defaultFilename()
+{
+	return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/userparts.manifest";
+}
+
+void PartsManifest::load()
+{
+	m_entries.clear();
+	m_kept.clear();
+	m_changed = false;
+
+	QFile file(m_filename);
+	if (!file.open(QFile::ReadOnly)) return;
+
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_6_0);
+	quint32 magic = 0;
+	qint32 version = 0;
+	stream >> magic >> version;
+	if (magic != ManifestMagic || version != ManifestVersion) {
+		m_changed = true;
+		return;
+	}
+
+	qint32 count = 0;
+	stream >> count;
+	for (int i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+		QString path;
+		Entry entry;
+		stream >> path >> entry.size >> entry.modified >> entry.itemType >> entry.fields;
+		m_entries.insert(path, entry);
+	}
+
+	if (stream.status() != QDataStream::Ok) {
+		DebugDialog::debug(QString("discarding corrupt parts manifest %1").arg(m_filename));
+		m_entries.clear();
+		m_changed = true;
+	}
+}
+
+bool PartsManifest::save()
+{
+	// entries for parts that were not loaded this time (deleted or moved) are dropped
+	if (m_kept.count() != m_entries.count()) {
+		m_changed = true;
+	}
+	if (!m_changed) return true;
+
+	QDir().mkpath(QFileInfo(m_filename).absolutePath());
+	QSaveFile file(m_filename);
+	if (!file.open(QFile::WriteOnly)) {
+		DebugDialog::debug(QString("unable to write parts manifest %1").arg(m_filename));
+		return false;
+	}
+
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_6_0);
+	stream << ManifestMagic << ManifestVersion << static_cast<qint32>(m_kept.count());
+	Q_FOREACH (const QString & path, m_kept) {
+		const Entry & entry = m_entries[path];
+		stream << path << entry.size << entry.modified << entry.itemType << entry.fields;
+	}
+
+	if (!file.commit()) return false;
+
+	m_changed = false;
+	return true;
+}
+
+bool PartsManifest::find(const QFileInfo & info, int & itemType, QByteArray & fields) const
+{
+	auto it = m_entries.constFind(info.absoluteFilePath());
+	if (it == m_entries.constEnd()) return false;
+	if (it->size != info.size()) return false;
+	if (it->modified != info.lastModified().toMSecsSinceEpoch()) return false;
+
+	itemType = it->itemType;
+	fields = it->fields;
+	return true;
+}
+
+void PartsManifest::insert(const QFileInfo & info, int itemType, const QByteArray & fields)
+{
+	Entry entry;
+	entry.size = info.size();
+	entry.modified = info.lastModified().toMSecsSinceEpoch();
+	entry.itemType = itemType;
+	entry.fields = fields;
+	m_entries.insert(info.absoluteFilePath(), entry);
+	m_kept.insert(info.absoluteFilePath());
+	m_changed = true;
+}
+
+void PartsManifest::keep(const QString & path)
+{
+	if (m_entries.contains(path)) {
+		m_kept.insert(path);
+	}
+}
@@ -0,0 +1,63 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+
+#ifndef PARTSMANIFEST_H
+#define PARTSMANIFEST_H
+
+#include <QByteArray>
+#include <QFileInfo>
+#include <QHash>
+#include <QSet>
+#include <QString>
+
+class PartsManifest
+{
+	// Remembers what was read from each user part's fzp, keyed by path, size and modification time,
+	// so unchanged user parts are restored on startup without parsing them again.
+	// find() may be called from worker threads once load() has returned; everything else belongs to one thread.
+
+public:
+	PartsManifest(const QString & filename);
+
+	void load();
+	bool save();
+	bool find(const QFileInfo &, int & itemType, QByteArray & fields) const;
+	void insert(const QFileInfo &, int itemType, const QByteArray & fields);
+	void keep(const QString & path);
+
+public:
+	static QString defaultFilename();
+
+protected:
+	struct Entry {
+		qint64 size = 0;
+		qint64 modified = 0;
+		qint32 itemType = 0;
+		QByteArray fields;
+	};
+
+	QString m_filename;
+	QHash<QString, Entry> m_entries;
+	QSet<QString> m_kept;
+	bool m_changed = false;
+};
+
+#endif
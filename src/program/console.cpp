@@ -49,22 +49,62 @@
 Console::Console(QWidget *parent)
 	: QPlainTextEdit(parent)
 	, localEchoEnabled(false)
+	, decoder(QStringDecoder::Utf8)
 {
-	document()->setMaximumBlockCount(1000);
+	document()->setMaximumBlockCount(10000);
+	document()->setUndoRedoEnabled(false);
 	QFont font = document()->defaultFont();
 	font.setFamily("Droid Sans Mono");
 	document()->setDefaultFont(font);
 	//setCenterOnScroll(true);
+
+	flushTimer.setSingleShot(true);
+	flushTimer.setInterval(FlushIntervalMS);
+	connect(&flushTimer, SIGNAL(timeout()), this, SLOT(flushData()));
 }
 
 void Console::putData(const QByteArray &data)
 {
-	insertPlainText(QString(data));
+	// buffer here and let flushData() update the widget at a capped rate,
+	// so a board streaming at full speed does not relayout the document on every read
+	pending.append(data);
+	if (pending.size() > MaxPendingBytes) {
+		pending.remove(0, pending.size() - MaxPendingBytes);
+	}
+
+	if (!flushTimer.isActive()) {
+		flushTimer.start();
+	}
+}
+
+void Console::flushData()
+{
+	if (pending.isEmpty()) return;
+
+	// the decoder keeps state, so a multi-byte character split across reads survives
+	QString text = decoder.decode(pending);
+	pending.clear();
+
+	QTextCursor cursor(document());
+	cursor.movePosition(QTextCursor::End);
+	cursor.insertText(text);
 
 	QScrollBar *bar = verticalScrollBar();
 	bar->setValue(bar->maximum());
 }
 
+void Console::setMaximumScrollback(int lines)
+{
+	document()->setMaximumBlockCount(lines);
+}
+
+void Console::clear()
+{
+	pending.clear();
+	flushTimer.stop();
+	QPlainTextEdit::clear();
+}
+
 void Console::setLocalEchoEnabled(bool set)
 {
 	localEchoEnabled = set;
@@ -44,6 +44,8 @@
 #define CONSOLE_H
 
 #include <QPlainTextEdit>
+#include <QTimer>
+#include <QStringDecoder>
 
 class Console : public QPlainTextEdit
 {
@@ -58,6 +60,13 @@ public:
 	void putData(const QByteArray &data);
 
 	void setLocalEchoEnabled(bool set);
+	void setMaximumScrollback(int lines);
+
+public Q_SLOTS:
+	void clear();
+
+protected Q_SLOTS:
+	void flushData();
 
 protected:
 	virtual void keyPressEvent(QKeyEvent *e);
@@ -67,6 +76,14 @@ protected:
 
 private:
 	bool localEchoEnabled;
+	QByteArray pending;
+	QTimer flushTimer;
+	QStringDecoder decoder;
+
+	// incoming data is shown at most this often, however fast it arrives
+	static constexpr int FlushIntervalMS = 33;
+	// pending data beyond this is dropped from the front; the widget could not show more anyway
+	static constexpr int MaxPendingBytes = 1024 * 1024;
 
 };
 
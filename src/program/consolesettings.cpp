@@ -46,6 +46,7 @@
 #include <QtSerialPort/QSerialPortInfo>
 #include <QIntValidator>
 #include <QLineEdit>
+#include <QSettings>
 
 QT_USE_NAMESPACE
 
@@ -69,6 +70,11 @@ ConsoleSettings::ConsoleSettings(QWidget *parent) :
 	fillPortsParameters();
 	fillPortsInfo();
 
+	QSettings settings;
+	ui->scrollbackSpinBox->setValue(settings.value("consolewindow/maxScrollback", ui->scrollbackSpinBox->value()).toInt());
+	ui->logFileEdit->setText(settings.value("consolewindow/logFile").toString());
+	ui->logFileCheckBox->setChecked(settings.value("consolewindow/logEnabled", false).toBool());
+
 	updateSettings();
 }
 
@@ -205,4 +211,12 @@ void ConsoleSettings::updateSettings()
 	currentSettings.stringFlowControl = ui->flowControlBox->currentText();
 
 	currentSettings.localEchoEnabled = ui->localEchoCheckBox->isChecked();
+
+	currentSettings.maxScrollback = ui->scrollbackSpinBox->value();
+	currentSettings.logFileName = ui->logFileCheckBox->isChecked() ? ui->logFileEdit->text().trimmed() : QString();
+
+	QSettings settings;
+	settings.setValue("consolewindow/maxScrollback", currentSettings.maxScrollback);
+	settings.setValue("consolewindow/logFile", ui->logFileEdit->text().trimmed());
+	settings.setValue("consolewindow/logEnabled", ui->logFileCheckBox->isChecked());
 }
@@ -76,6 +76,8 @@ public:
 		QSerialPort::FlowControl flowControl;
 		QString stringFlowControl;
 		bool localEchoEnabled;
+		int maxScrollback;
+		QString logFileName;
 	};
 
 	explicit ConsoleSettings(QWidget *parent = 0);
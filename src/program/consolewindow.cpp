@@ -143,6 +143,8 @@ void ConsoleWindow::openSerialPort()
 		serial->setFlowControl(p.flowControl);
 		console->setEnabled(true);
 		console->setLocalEchoEnabled(p.localEchoEnabled);
+		console->setMaximumScrollback(p.maxScrollback);
+		openLogFile(p.logFileName);
 		ui->actionConnect->setEnabled(false);
 		ui->actionDisconnect->setEnabled(true);
 		ui->actionConfigure->setEnabled(false);
@@ -168,6 +170,7 @@ void ConsoleWindow::closeSerialPort()
 {
 	if (serial->isOpen()) {
 		serial->close();
+		logFile.close();
 		console->setEnabled(false);
 		ui->actionConnect->setEnabled(true);
 		ui->actionDisconnect->setEnabled(false);
@@ -192,9 +195,24 @@ void ConsoleWindow::writeData(const QByteArray &data)
 void ConsoleWindow::readData()
 {
 	QByteArray data = serial->readAll();
+	if (logFile.isOpen()) {
+		// the log gets everything, even what the console drops under load
+		logFile.write(data);
+	}
 	console->putData(data);
 }
 
+void ConsoleWindow::openLogFile(const QString & fileName)
+{
+	logFile.close();
+	if (fileName.isEmpty()) return;
+
+	logFile.setFileName(fileName);
+	if (!logFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
+		ui->statusBar->showMessage(tr("Unable to open log file %1: %2").arg(fileName).arg(logFile.errorString()));
+	}
+}
+
 void ConsoleWindow::handleError(QSerialPort::SerialPortError error)
 {
 	if (error == QSerialPort::ResourceError) {
@@ -48,6 +48,7 @@
 #include <QMainWindow>
 
 #include <QtSerialPort/QSerialPort>
+#include <QFile>
 
 QT_BEGIN_NAMESPACE
 
@@ -83,12 +84,14 @@ private Q_SLOTS:
 
 private:
 	void initActionsConnections();
+	void openLogFile(const QString & fileName);
 
 private:
 	Ui::ConsoleWindow *ui;
 	Console *console;
 	ConsoleSettings *settings;
 	QSerialPort *serial;
+	QFile logFile;
 };
 
 #endif // CONSOLEWINDOW_H
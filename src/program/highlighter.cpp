@@ -18,12 +18,9 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 
 ********************************************************************/
 
-#include <QRegularExpression>
-
 #include "highlighter.h"
 #include "syntaxer.h"
 
-#include "../utils/textutils.h"
 #include "../debugdialog.h"
 
 #include <stdlib.h>
@@ -31,6 +28,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #define STRINGOFFSET 10
 #define COMMENTOFFSET 100
 static const QChar CEscapeChar('\\');
+static const QChar CQuoteChar('\'');
 
 QHash <QString, QTextCharFormat *> Highlighter::m_styleFormats;
 
@@ -92,12 +90,23 @@ void Highlighter::loadStyles(const QString & filename) {
 
 void Highlighter::setSyntaxer(Syntaxer * syntaxer) {
 	m_syntaxer = syntaxer;
+	initFormats();
 }
 
 Syntaxer * Highlighter::syntaxer() {
 	return m_syntaxer;
 }
 
+void Highlighter::initFormats() {
+	// leaves belong to the syntaxer, so their formats are looked up again for a new one
+	m_leafFormats.clear();
+	m_commentFormat = m_styleFormats.value("Comment", nullptr);
+	m_stringFormat = m_styleFormats.value("String", nullptr);
+	m_constantFormat = m_styleFormats.value("Constant", nullptr);
+	m_floatFormat = m_styleFormats.value("Float", nullptr);
+	m_hexFormat = m_styleFormats.value("Hex", nullptr);
+}
+
 void Highlighter::highlightBlock(const QString &text)
 {
 	if (m_syntaxer == nullptr) return;
@@ -108,147 +117,203 @@ void Highlighter::highlightBlock(const QString &text)
 	}
 
 	setCurrentBlockState(0);
-	int startCommentIndex = -1;
-	int startStringIndex = -1;
-	const CommentInfo * currentCommentInfo = nullptr;
+
+	// a single left-to-right pass: each token is formatted as soon as it is recognized,
+	// so comments hide strings and numbers (and vice versa) without copying the text
+	int pos = 0;
 	int pbs = previousBlockState();
-	if (pbs <= 0) {
-		m_syntaxer->matchCommentStart(text, 0, startCommentIndex, currentCommentInfo);
-	}
-	else if (pbs >= COMMENTOFFSET) {
-		currentCommentInfo = m_syntaxer->getCommentInfo(previousBlockState() - COMMENTOFFSET);
-		startCommentIndex = 0;
+	if (pbs >= COMMENTOFFSET) {
+		pos = highlightComment(text, 0, m_syntaxer->getCommentInfo(pbs - COMMENTOFFSET), true);
 	}
 	else if (pbs == STRINGOFFSET) {
-		startStringIndex = 0;
+		pos = highlightString(text, 0, true);
 	}
 
-	QString noComment = text;
+	QChar stringDelimiter = m_syntaxer->stringDelimiter();
+	int textLength = text.length();
+	while (pos < textLength) {
+		QChar c = text.at(pos);
+		const CommentInfo * commentInfo = m_syntaxer->matchCommentAt(text, pos);
+		if (commentInfo != nullptr) {
+			pos = highlightComment(text, pos, commentInfo, false);
+		}
+		else if (!stringDelimiter.isNull() && c == stringDelimiter) {
+			pos = highlightString(text, pos, false);
+		}
+		else if (c == CQuoteChar) {
+			pos = highlightChar(text, pos);
+		}
+		else if (c.isDigit() || (c == '.' && pos + 1 < textLength && text.at(pos + 1).isDigit())) {
+			pos = highlightNumber(text, pos);
+		}
+		else if (isWordChar(c)) {
+			pos = highlightWord(text, pos);
+		}
+		else {
+			pos++;
+		}
+	}
+}
 
-	while (startCommentIndex >= 0) {
-		int endIndex = currentCommentInfo->m_multiLine ? text.indexOf(currentCommentInfo->m_end, startCommentIndex, currentCommentInfo->m_caseSensitive) : text.length();
-		int commentLength;
+int Highlighter::highlightComment(const QString & text, int start, const CommentInfo * commentInfo, bool continued) {
+	int end = text.length();
+	if (commentInfo->m_multiLine) {
+		int from = continued ? start : start + commentInfo->m_start.length();
+		int endIndex = text.indexOf(commentInfo->m_end, from, commentInfo->m_caseSensitive);
 		if (endIndex == -1) {
-			setCurrentBlockState(currentCommentInfo->m_index + COMMENTOFFSET);
-			commentLength = text.length() - startCommentIndex;
+			setCurrentBlockState(commentInfo->m_index + COMMENTOFFSET);
 		}
 		else {
-			commentLength = endIndex - startCommentIndex + currentCommentInfo->m_end.length();
-		}
-		noComment.replace(startCommentIndex, commentLength, QString(commentLength, ' '));
-		QTextCharFormat * cf = m_styleFormats.value("Comment", nullptr);
-		if (cf != nullptr) {
-			setFormat(startCommentIndex, commentLength, *cf);
+			end = endIndex + commentInfo->m_end.length();
 		}
-		m_syntaxer->matchCommentStart(text, startCommentIndex + commentLength, startCommentIndex, currentCommentInfo);
 	}
 
-	highlightStrings(startStringIndex, noComment);
-	highlightTerms(noComment);
-	highlightNumbers(noComment);
+	applyFormat(start, end - start, m_commentFormat);
+	return end;
+}
+
+int Highlighter::highlightString(const QString & text, int start, bool continued) {
+	QChar stringDelimiter = m_syntaxer->stringDelimiter();
+	// only some languages use \ to escape
+	bool escapes = m_syntaxer->hlCStringChar();
+	int textLength = text.length();
+	int end = -1;
+	// TODO: not handling "" as a way to escape-quote
+	for (int i = continued ? start : start + 1; i < textLength; i++) {
+		QChar c = text.at(i);
+		if (escapes && c == CEscapeChar) {
+			i++;
+			continue;
+		}
+		if (c == stringDelimiter) {
+			end = i + 1;
+			break;
+		}
+	}
 
-	// highlight single chars
-	applyRule(QRegularExpression(R"RX('.?')RX"), m_styleFormats.value("Constant", nullptr), text);
+	if (end == -1) {
+		setCurrentBlockState(STRINGOFFSET);
+		end = textLength;
+	}
 
+	applyFormat(start, end - start, m_stringFormat);
+	return end;
 }
 
-void Highlighter::highlightStrings(int startStringIndex, QString & text) {
-	if (startStringIndex < 0) {
-		startStringIndex = m_syntaxer->matchStringStart(text, 0);
+int Highlighter::highlightChar(const QString & text, int start) {
+	// 'c', '\n' or ''
+	int textLength = text.length();
+	int i = start + 1;
+	if (i < textLength && text.at(i) != CQuoteChar) {
+		if (text.at(i) == CEscapeChar) i++;
+		i++;
 	}
 
-	// TODO: not handling "" as a way to escape-quote
-	while (startStringIndex >= 0) {
-		int endIndex = -1;
-		int ssi = startStringIndex;
-		while (true) {
-			endIndex = m_syntaxer->matchStringEnd(text, ssi + 1);
-			if (!m_syntaxer->hlCStringChar()) {
-				// only some languages use \ to escape
-				break;
-			}
+	if (i < textLength && text.at(i) == CQuoteChar) {
+		applyFormat(start, i + 1 - start, m_constantFormat);
+		return i + 1;
+	}
 
-			if (endIndex == -1) {
-				break;
-			}
+	return start + 1;
+}
 
-			// TODO: escape char is backslash only; are there others in other compilers?
-			if (text.at(endIndex - 1) != CEscapeChar) {
-				break;
-			}
-			ssi = endIndex;
-		}
-		int stringLength;
-		if (endIndex == -1) {
-			setCurrentBlockState(STRINGOFFSET);
-			stringLength = text.length() - startStringIndex;
-		}
-		else {
-			stringLength = endIndex - startStringIndex + 1;
-		}
-		text.replace(startStringIndex, stringLength, QString(stringLength, ' '));
-		QTextCharFormat * sf = m_styleFormats.value("String", NULL);
-		if (sf != nullptr) {
-			setFormat(startStringIndex, stringLength, *sf);
-		}
-		startStringIndex = m_syntaxer->matchStringStart(text, startStringIndex + stringLength);
+static int skipDigits(const QString & text, int pos, int base) {
+	int textLength = text.length();
+	while (pos < textLength) {
+		QChar c = text.at(pos);
+		if (c.unicode() > 0x7f) break;
+
+		int digit;
+		char ch = c.toLatin1();
+		if (ch >= '0' && ch <= '9') digit = ch - '0';
+		else if (ch >= 'a' && ch <= 'f') digit = ch - 'a' + 10;
+		else if (ch >= 'A' && ch <= 'F') digit = ch - 'A' + 10;
+		else break;
+
+		if (digit >= base) break;
+		pos++;
 	}
+
+	return pos;
 }
 
-void Highlighter::highlightTerms(const QString & text) {
-	int lastWordBreak = 0;
+int Highlighter::highlightNumber(const QString & text, int start) {
 	int textLength = text.length();
-	int b;
-	while (lastWordBreak < textLength) {
-		for (b = lastWordBreak; b < textLength; b++) {
-			if (!isWordChar(text.at(b))) break;
+	QTextCharFormat * format = m_floatFormat;
+	int end = -1;
+
+	if (text.at(start) == '0' && start + 2 < textLength) {
+		// Hex and binary (use the hex style)
+		QChar radix = text.at(start + 1).toLower();
+		int base = (radix == 'x') ? 16 : (radix == 'b') ? 2 : 0;
+		if (base > 0) {
+			int e = skipDigits(text, start + 2, base);
+			if (e > start + 2) {
+				end = e;
+				format = m_hexFormat;
+			}
 		}
+	}
 
-		if (b > lastWordBreak) {
-			TrieLeaf * leaf = nullptr;
-			if (m_syntaxer->matches(text.mid(lastWordBreak, b - lastWordBreak), leaf)) {
-				auto * stl = dynamic_cast<SyntaxerTrieLeaf *>(leaf);
-				if (stl != nullptr) {
-					QString format = Syntaxer::formatFromList(stl->name());
-					QTextCharFormat * tcf = m_styleFormats.value(format, NULL);
-					if (tcf != nullptr) {
-						setFormat(lastWordBreak, b - lastWordBreak, *tcf);
-					}
-				}
+	if (end == -1) {
+		// Floats, but also Integers
+		end = skipDigits(text, start, 10);
+		bool integer = true;
+		if (end < textLength && text.at(end) == '.') {
+			end = skipDigits(text, end + 1, 10);
+			integer = false;
+		}
+		if (end < textLength && text.at(end).toLower() == 'e') {
+			int e = end + 1;
+			if (e < textLength && (text.at(e) == '+' || text.at(e) == '-')) e++;
+			if (e < textLength && text.at(e).isDigit()) {
+				end = skipDigits(text, e, 10);
+				integer = false;
 			}
 		}
 
-		lastWordBreak = b + 1;
+		// Octal (use the hex style)
+		if (integer && text.at(start) == '0' && end > start + 1 && skipDigits(text, start, 8) == end) {
+			format = m_hexFormat;
+		}
 	}
+
+	applyFormat(start, end - start, format);
+
+	// suffixes such as UL or f are not colored
+	while (end < textLength && isWordChar(text.at(end))) end++;
+	return end;
 }
 
-void Highlighter::highlightNumbers(const QString &text) {
+int Highlighter::highlightWord(const QString & text, int start) {
+	int textLength = text.length();
+	int end = start;
+	while (end < textLength && isWordChar(text.at(end))) end++;
 
-	// Floats , but also Integers
-	auto * floatStyle(m_styleFormats.value("Float", nullptr));
-	applyRule(TextUtils::floatingPointMatcher, floatStyle, text);
+	TrieLeaf * leaf = nullptr;
+	if (m_syntaxer->matches(QStringView(text).mid(start, end - start), leaf)) {
+		applyFormat(start, end - start, formatFromLeaf(leaf));
+	}
 
-	// Hex
-	auto * hexStyle(m_styleFormats.value("Hex", nullptr));
-	QRegularExpression hexRule(R"RX((\b0x[\dA-F]+\b))RX", QRegularExpression::CaseInsensitiveOption);
-	applyRule(hexRule, hexStyle, text);
+	return end;
+}
 
-	// Octal (use the hex style)
-	QRegularExpression octalRule(R"RX((\b0[0-7]+\b))RX");
-	applyRule(octalRule, hexStyle, text);
+QTextCharFormat * Highlighter::formatFromLeaf(TrieLeaf * leaf) {
+	auto it = m_leafFormats.constFind(leaf);
+	if (it != m_leafFormats.constEnd()) return it.value();
 
-	// Binary (use the hex style)
-	QRegularExpression binaryRule(R"RX((\b0b[01]+\b))RX", QRegularExpression::CaseInsensitiveOption);
-	applyRule(binaryRule, hexStyle, text);
+	QTextCharFormat * tcf = nullptr;
+	auto * stl = dynamic_cast<SyntaxerTrieLeaf *>(leaf);
+	if (stl != nullptr) {
+		tcf = m_styleFormats.value(Syntaxer::formatFromList(stl->name()), nullptr);
+	}
+	m_leafFormats.insert(leaf, tcf);
+	return tcf;
 }
 
-void Highlighter::applyRule(const QRegularExpression & rule, QTextCharFormat * format, const QString & text) {
-	if (format) { // only apply style if it is present in the styles.xml
-		QRegularExpressionMatchIterator matchIterator = rule.globalMatch(text);
-		while (matchIterator.hasNext()) {
-			QRegularExpressionMatch match = matchIterator.next();
-			setFormat(match.capturedStart(), match.capturedLength(), *format);
-		}
+void Highlighter::applyFormat(int start, int count, QTextCharFormat * format) {
+	if (format != nullptr && count > 0) { // only apply style if it is present in the styles.xml
+		setFormat(start, count, *format);
 	}
 }
 
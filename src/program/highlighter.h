@@ -45,13 +45,23 @@ public:
 protected:
 	void highlightBlock(const QString & text);
 	bool isWordChar(QChar c);
-	void applyRule(const QRegularExpression & rule, QTextCharFormat * format, const QString & text);
-	void highlightTerms(const QString & text);
-	void highlightStrings(int startStringIndex, QString & text);
-	void highlightNumbers(const QString & text);
+	int highlightComment(const QString & text, int start, const class CommentInfo * commentInfo, bool continued);
+	int highlightString(const QString & text, int start, bool continued);
+	int highlightChar(const QString & text, int start);
+	int highlightNumber(const QString & text, int start);
+	int highlightWord(const QString & text, int start);
+	void applyFormat(int start, int count, QTextCharFormat * format);
+	QTextCharFormat * formatFromLeaf(class TrieLeaf *);
+	void initFormats();
 
 protected:
 	QPointer<class Syntaxer> m_syntaxer;
+	QHash<class TrieLeaf *, QTextCharFormat *> m_leafFormats;
+	QTextCharFormat * m_commentFormat = nullptr;
+	QTextCharFormat * m_stringFormat = nullptr;
+	QTextCharFormat * m_constantFormat = nullptr;
+	QTextCharFormat * m_floatFormat = nullptr;
+	QTextCharFormat * m_hexFormat = nullptr;
 
 	static QHash<QString, QTextCharFormat *> m_styleFormats;
 };
@@ -115,6 +115,14 @@ bool Syntaxer::loadSyntax(const QString &filename)
 			auto * commentInfo = new CommentInfo(comment.attribute("start"), comment.attribute("end"), caseSensitivity);
 			commentInfo->m_index = m_commentInfo.count();
 			m_commentInfo.append(commentInfo);
+			if (!commentInfo->m_start.isEmpty()) {
+				QChar lead = commentInfo->m_start.at(0);
+				m_commentLeadChars.append(lead);
+				if (caseSensitivity == Qt::CaseInsensitive) {
+					m_commentLeadChars.append(lead.toLower());
+					m_commentLeadChars.append(lead.toUpper());
+				}
+			}
 			comment = comment.nextSiblingElement("comment");
 		}
 	}
@@ -158,38 +166,34 @@ void Syntaxer::loadList(QDomElement & list) {
 	}
 }
 
-bool Syntaxer::matches(const QString & string, TrieLeaf * & leaf) {
+bool Syntaxer::matches(QStringView string, TrieLeaf * & leaf) {
 	if (m_trieRoot == nullptr) return false;
 
-	QString temp = string;
-	return m_trieRoot->matches(temp, leaf);
+	return m_trieRoot->matches(string, leaf);
 }
 
 const CommentInfo * Syntaxer::getCommentInfo(int ix) {
 	return m_commentInfo.at(ix);
 }
 
-bool Syntaxer::matchCommentStart(const QString & text, int offset, int & result, const CommentInfo * & resultCommentInfo) {
-	result = -1;
+const CommentInfo * Syntaxer::matchCommentAt(QStringView text, int offset) {
+	// most characters can't start a comment, so reject them before comparing strings
+	if (!m_commentLeadChars.contains(text.at(offset))) return nullptr;
+
+	QStringView rest = text.mid(offset);
 	Q_FOREACH (CommentInfo * commentInfo, m_commentInfo) {
-		int si = text.indexOf(commentInfo->m_start, offset, commentInfo->m_caseSensitive);
-		if (si >= 0 && (result < 0 || si < result)) {
-			result = si;
-			resultCommentInfo = commentInfo;
+		if (commentInfo->m_start.isEmpty()) continue;
+
+		if (rest.startsWith(commentInfo->m_start, commentInfo->m_caseSensitive)) {
+			return commentInfo;
 		}
 	}
 
-	return (result >= offset);
-}
-
-int Syntaxer::matchStringStart(const QString & text, int offset) {
-	if (m_stringDelimiter.isNull()) return -1;
-
-	return text.indexOf(m_stringDelimiter, offset);
+	return nullptr;
 }
 
-int Syntaxer::matchStringEnd(const QString & text, int offset) {
-	return matchStringStart(text, offset);
+QChar Syntaxer::stringDelimiter() {
+	return m_stringDelimiter;
 }
 
 const QStringList & Syntaxer::extensions() {
@@ -52,11 +52,10 @@ public:
 	virtual ~Syntaxer();
 
 	bool loadSyntax(const QString & filename);
-	bool matches(const QString & string, TrieLeaf * & leaf);
+	bool matches(QStringView string, TrieLeaf * & leaf);
 	const CommentInfo * getCommentInfo(int ix);
-	bool matchCommentStart(const QString & text, int offset, int & result, const CommentInfo * & resultCommentInfo);
-	int matchStringStart(const QString & text, int offset);
-	int matchStringEnd(const QString & text, int offset);
+	const CommentInfo * matchCommentAt(QStringView text, int offset);
+	QChar stringDelimiter();
 	const QString & extensionString();
 	const QStringList & extensions();
 	bool hlCStringChar();
@@ -80,6 +79,7 @@ protected:
 	QString m_extensionString;
 	QStringList m_extensions;
 	QList<CommentInfo *> m_commentInfo;
+	QString m_commentLeadChars;
 	QChar m_stringDelimiter = QChar();
 	bool m_hlCStringChar = false;
 	bool m_canProgram = false;
@@ -25,6 +25,8 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <QXmlStreamReader>
 
+#include <utility>
+
 
 TrieLeaf::TrieLeaf()
 {
@@ -95,22 +97,26 @@ bool TrieNode::matchesChar(QChar c) {
 	return (c == m_char);
 }
 
-bool TrieNode::matches(QString & string, TrieLeaf * & leaf)
+bool TrieNode::matches(QStringView string, TrieLeaf * & leaf)
 {
-	if (string.isEmpty()) {
-		if (m_isLeaf) {
-			leaf = m_leafData;
-			return true;
+	// walk the trie in place; this is called for every word in the code view
+	TrieNode * node = this;
+	for (QChar in : string) {
+		TrieNode * next = nullptr;
+		for (TrieNode * child : std::as_const(node->m_children)) {
+			if (child->matchesChar(in)) {
+				next = child;
+				break;
+			}
 		}
+		if (next == nullptr) return false;
 
-		return false;
+		node = next;
 	}
 
-	QChar in(string.at(0));
-	Q_FOREACH (TrieNode * node, m_children) {
-		if (node->matchesChar(in)) {
-			return node->matches(string.remove(0, 1), leaf);
-		}
+	if (node->m_isLeaf) {
+		leaf = node->m_leafData;
+		return true;
 	}
 
 	return false;
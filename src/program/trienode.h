@@ -24,6 +24,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <QChar>
 #include <QList>
+#include <QStringView>
 
 class TrieLeaf {
 public:
@@ -38,7 +39,7 @@ public:
 	virtual ~TrieNode();
 
 	virtual void addString(QString & s, bool caseInsensitive, TrieLeaf * leaf);
-	virtual bool matches(QString & string, TrieLeaf * & leaf);
+	virtual bool matches(QStringView string, TrieLeaf * & leaf);
 
 protected:
 	virtual void addStringAux(QChar c, QString & next, bool caseInsensitive, TrieLeaf * leaf);
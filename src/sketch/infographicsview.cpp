@@ -386,6 +386,11 @@ void InfoGraphicsView::resolveTemporary(bool, ItemBase *)
 {
 }
 
+ConnectorIndex * InfoGraphicsView::dragConnectorIndex()
+{
+	return nullptr;
+}
+
 void InfoGraphicsView::setSMDOrientation(Qt::Orientations orientation) {
 	m_smdOrientation = orientation;
 }
@@ -103,6 +103,7 @@ public:
 	virtual void changeWireColor(const QString newColor);
 	virtual void swap(const QString & family, const QString & prop, QMap<QString, QString> & propsMap, ItemBase *);
 	virtual void resolveTemporary(bool, ItemBase *);
+	virtual class ConnectorIndex * dragConnectorIndex();
 
 	void setActiveWire(Wire *);
 	void setActiveConnectorItem(ConnectorItem *);
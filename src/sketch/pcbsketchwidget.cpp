@@ -38,6 +38,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "utils/textutils.h"
 #include "processeventblocker.h"
 #include "autoroute/autoroutersettingsdialog.h"
+#include "autoroute/autorouter.h"
 #include "svg/groundplanegenerator.h"
 #include "svg/groundplanegeneratorold.h"
 #include "items/logoitem.h"
@@ -2765,7 +2766,7 @@ QHash<QString, QString> PCBSketchWidget::getAutorouterSettings() {
 
 void PCBSketchWidget::setAutorouterSettings(QHash<QString, QString> & autorouterSettings) {
 	QList<QString> keys;
-	keys << DRC::KeepoutSettingName << AutorouterSettingsDialog::AutorouteTraceWidth << Via::AutorouteViaHoleSize << Via::AutorouteViaRingThickness << GroundPlaneGenerator::KeepoutSettingName;
+	keys << DRC::KeepoutSettingName << AutorouterSettingsDialog::AutorouteTraceWidth << Via::AutorouteViaHoleSize << Via::AutorouteViaRingThickness << GroundPlaneGenerator::KeepoutSettingName << Autorouter::NegotiatedName;
 	Q_FOREACH (QString key, keys) {
 		m_autorouterSettings.insert(key, autorouterSettings.value(key, ""));
 	}
@@ -41,6 +41,8 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QScrollBar>
 #include <QStatusBar>
 #include <QOpenGLWidget>
+#include <QImage>
+#include <QPainter>
 
 #include <limits>
 
@@ -58,6 +60,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "subpartswapmanager.h"
 #include "../connectors/connectoritem.h"
 #include "../connectors/svgidlayer.h"
+#include "../svg/svgfragmentcache.h"
 #include "../items/jumperitem.h"
 #include "../items/stripboard.h"
 #include "../items/virtualwire.h"
@@ -123,7 +126,23 @@ enum ConnectionStatus {
 static constexpr double CloseEnough = 0.5;  // in pixels, for swapping into the breadboard
 
 static constexpr int AutoRepeatDelay = 750;
+
+static constexpr int DragCacheThreshold = 24;  // dragging at least this many parts draws them from pixmap caches
+
+// at or below this device scale parts are drawn from pixmaps rendered at the next power of two above the scale
+static constexpr double LevelOfDetailThreshold = 0.5;
+static constexpr double MinLevelOfDetailScale = 1.0 / 64;
+
+static constexpr int GridTilePixels = 256;  // the grid is filled from a tile of whole cells at least this many pixels wide
+
+static constexpr int PanBenchmarkStep = 16;  // pixels the -panbench view moves per frame
+static const QSize PanBenchmarkSize(1280, 800);
 bool SketchWidget::m_blockUI = false;
+QDomDocument SketchWidget::ClipboardDocument;
+QByteArray SketchWidget::ClipboardID;
+qint64 SketchWidget::ClipboardCount = 0;
+
+static const QString ClipboardIDMimeType("application/x-fritzing-clipboard-id");
 
 /////////////////////////////////////////////////////////////////////
 
@@ -178,6 +197,7 @@ SketchWidget::SketchWidget(ViewLayer::ViewID viewID, QWidget *parent, int size,
 	m_sizeItem->setVisible(false);
 
 	connect(this->scene(), SIGNAL(selectionChanged()), this, SLOT(selectionChangedSlot()));
+	connect(this, SIGNAL(zoomChanged(double)), this, SLOT(updateLevelOfDetail()));
 
 	connect(QApplication::clipboard(),SIGNAL(changed(QClipboard::Mode)),this,SLOT(restartPasteCount()));
 	restartPasteCount(); // the first time
@@ -910,6 +930,8 @@ PaletteItem* SketchWidget::addPartItem(ModelPart * modelPart, ViewLayer::ViewLay
 
 void SketchWidget::addToScene(ItemBase * item, ViewLayer::ViewLayerID viewLayerID) {
 	scene()->addItem(item);
+	m_dragConnectorIndex.clear();
+	applyLevelOfDetail(item, m_levelOfDetailScale);
 	item->setSelected(true);
 	item->setHidden(!layerIsVisible(viewLayerID));
 	item->setInactive(!layerIsActive(viewLayerID));
@@ -994,6 +1016,7 @@ void SketchWidget::deleteItem(ItemBase * itemBase, bool deleteModelPart, bool do
 
 	itemBase->removeLayerKin();
 	this->scene()->removeItem(itemBase);
+	m_dragConnectorIndex.clear();
 
 	if (later) {
 		itemBase->deleteLater();
@@ -1626,11 +1649,20 @@ void SketchWidget::copyAux(QList<ItemBase *> & bases, bool saveBoundingRects)
 	copyHeart(bases, saveBoundingRects, itemData, modelIndexes);
 
 	// only preserve connections for copied items that connect to each other
-	QByteArray newItemData = removeOutsideConnections(itemData, modelIndexes);
+	QDomDocument domDocument;
+	if (!removeOutsideConnections(itemData, modelIndexes, domDocument)) return;
+
+	QByteArray newItemData = domDocument.toByteArray();
+
+	// keep the parsed document so a paste within this process does not have to reparse the xml;
+	// the id tells the paste whether the clipboard still holds what was copied here
+	ClipboardDocument = domDocument;
+	ClipboardID = QString("%1:%2").arg(QCoreApplication::applicationPid()).arg(++ClipboardCount).toUtf8();
 
 	auto *mimeData = new QMimeData;
 	mimeData->setData("application/x-dnditemsdata", newItemData);
 	mimeData->setData("text/plain", newItemData);
+	mimeData->setData(ClipboardIDMimeType, ClipboardID);
 
 	QClipboard *clipboard = QApplication::clipboard();
 	if (!clipboard) {
@@ -1698,23 +1730,34 @@ void SketchWidget::copyHeart(QList<ItemBase *> & bases, bool saveBoundingRects,
 	streamWriter.writeEndElement();
 }
 
-QByteArray SketchWidget::removeOutsideConnections(const QByteArray & itemData, QList<long> & modelIndexes) {
+bool SketchWidget::clipboardDocument(const QMimeData * mimeData, QDomDocument & domDocument) {
+	if (ClipboardDocument.isNull()) return false;
+	if (!mimeData->hasFormat(ClipboardIDMimeType)) return false;
+	if (mimeData->data(ClipboardIDMimeType) != ClipboardID) return false;
+
+	// pasting modifies the document, and the model parts hang on to its elements, so every paste needs its own copy
+	domDocument = ClipboardDocument.cloneNode(true).toDocument();
+	return true;
+}
+
+bool SketchWidget::removeOutsideConnections(const QByteArray & itemData, QList<long> & modelIndexes, QDomDocument & domDocument) {
 	// now have to remove each connection that points to a part outside of the set of parts being copied
 
-	QDomDocument domDocument;
 	QString errorStr;
 	int errorLine;
 	int errorColumn;
 	bool result = domDocument.setContent(itemData, &errorStr, &errorLine, &errorColumn);
-	if (!result) return ___emptyByteArray___;
+	if (!result) return false;
 
 	QDomElement root = domDocument.documentElement();
 	if (root.isNull()) {
-		return ___emptyByteArray___;
+		return false;
 	}
 
 	QDomElement instances = root.firstChildElement("instances");
-	if (instances.isNull()) return ___emptyByteArray___;
+	if (instances.isNull()) return false;
+
+	QSet<long> copiedIndexes(modelIndexes.begin(), modelIndexes.end());
 
 	QDomElement instance = instances.firstChildElement("instance");
 	while (!instance.isNull()) {
@@ -1732,7 +1775,7 @@ QByteArray SketchWidget::removeOutsideConnections(const QByteArray & itemData, Q
 							QList<QDomElement> toDelete;
 							while (!connect.isNull()) {
 								long modelIndex = connect.attribute("modelIndex").toLong();
-								if (!modelIndexes.contains(modelIndex)) {
+								if (!copiedIndexes.contains(modelIndex)) {
 									toDelete.append(connect);
 								}
 
@@ -1757,12 +1800,13 @@ QByteArray SketchWidget::removeOutsideConnections(const QByteArray & itemData, Q
 		instance = instance.nextSiblingElement("instance");
 	}
 
-	return domDocument.toByteArray();
+	return true;
 }
 
 
 void SketchWidget::dragEnterEvent(QDragEnterEvent *event)
 {
+	enableDragConnectorIndex(true);
 	if (dragEnterEventAux(event)) {
 		setupAutoscroll(false);
 		event->acceptProposedAction();
@@ -1888,6 +1932,7 @@ bool SketchWidget::canDropModelPart(ModelPart * modelPart) {
 void SketchWidget::dragLeaveEvent(QDragLeaveEvent * event) {
 	Q_UNUSED(event);
 	turnOffAutoscroll();
+	enableDragConnectorIndex(false);
 
 	if (m_droppingItem) {
 		if (m_clearSceneRect) {
@@ -1961,9 +2006,26 @@ void SketchWidget::dragMoveHighlightConnector(QPoint eventPos) {
 
 }
 
+void SketchWidget::enableDragConnectorIndex(bool enable) {
+	// connector lookups during a drag go through a grid built on the first query (see ConnectorItem::findConnectorUnder);
+	// the scene's own index is rebuilt continually while items move. Adding or deleting items drops the grid
+	m_dragConnectorIndexEnabled = enable;
+	m_dragConnectorIndex.clear();
+}
+
+ConnectorIndex * SketchWidget::dragConnectorIndex() {
+	if (!m_dragConnectorIndexEnabled) return nullptr;
+
+	if (!m_dragConnectorIndex.isBuilt()) {
+		m_dragConnectorIndex.build(scene());
+	}
+	return &m_dragConnectorIndex;
+}
+
 void SketchWidget::dropEvent(QDropEvent *event)
 {
 	m_alignmentItem = nullptr;
+	enableDragConnectorIndex(false);
 
 	turnOffAutoscroll();
 	clearHoldingSelectItem();
@@ -2229,6 +2291,7 @@ void SketchWidget::mousePressEvent(QMouseEvent *event)
 	if (m_movingByArrow) return;
 
 	m_movingByMouse = true;
+	enableDragConnectorIndex(true);
 
 	QMouseEvent * hackEvent = nullptr;
 	if (event->button() == Qt::MiddleButton && !spaceBarIsPressed()) {
@@ -3031,6 +3094,8 @@ void SketchWidget::mouseMoveEvent(QMouseEvent *event) {
 				m_movingByMouse = false;
 
 				drag->exec();
+				enableDragConnectorIndex(false);
+				setDragCache(false);
 
 				delete m_movingSVGRenderer;
 				m_movingSVGRenderer = nullptr;
@@ -3143,6 +3208,7 @@ void SketchWidget::moveItemsAux(QPointF scenePos, QPoint globalPos, bool checkAu
 			//DebugDialog::debug(QString("disconnecting from female %1").arg(item->instanceTitle()));
 			disconnectFromFemale(item, m_savedItems, m_moveDisconnectedFromFemale, false, rubberBandLegEnabled, nullptr);
 		}
+		setDragCache(true);
 	}
 
 	Q_FOREACH (ItemBase * itemBase, m_savedItems) {
@@ -3189,16 +3255,81 @@ void SketchWidget::moveItemsAux(QPointF scenePos, QPoint globalPos, bool checkAu
 }
 
 
+void SketchWidget::setDragCache(bool enable) {
+	// a large selection is translated on every mouse move; with DeviceCoordinateCache each part
+	// is rendered once and then blitted, instead of going through QSvgRenderer per frame.
+	// The parts still move for real, so connector snapping and stretched wires stay live
+	if (!enable) {
+		Q_FOREACH (QPointer<ItemBase> itemBase, m_dragCachedItems) {
+			if (itemBase) {
+				itemBase->setCacheMode(QGraphicsItem::NoCache);
+				applyLevelOfDetail(itemBase, m_levelOfDetailScale);
+			}
+		}
+		m_dragCachedItems.clear();
+		return;
+	}
+
+	if (!m_dragCachedItems.isEmpty()) return;
+	if (m_savedItems.count() < DragCacheThreshold) return;
+
+	Q_FOREACH (ItemBase * itemBase, m_savedItems) {
+		if (itemBase->itemType() == ModelPart::Wire) continue;  // cheap to draw, and may be stretched
+		if (m_stretchingLegs.contains(itemBase)) continue;  // leg geometry changes on every move
+
+		QList<ItemBase *> itemBases(itemBase->layerKin());
+		itemBases.prepend(itemBase);
+		Q_FOREACH (ItemBase * kin, itemBases) {
+			if (kin->cacheMode() != QGraphicsItem::NoCache) continue;
+
+			kin->setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+			m_dragCachedItems.append(kin);
+		}
+	}
+}
+
 void SketchWidget::findConnectorsUnder(ItemBase * item) {
 	Q_UNUSED(item);
 }
 
+double SketchWidget::levelOfDetailScale() {
+	// 0 means parts are rendered directly
+	double scale = currentZoom() / 100 * devicePixelRatioF();
+	if (scale > LevelOfDetailThreshold) return 0;
+
+	return qPow(2, qCeil(std::log2(qMax(scale, MinLevelOfDetailScale))));
+}
+
+void SketchWidget::applyLevelOfDetail(ItemBase * itemBase, double scale) {
+	// zoomed out, rendering every part through its svg renderer on each paint dominates panning;
+	// instead each part keeps a pixmap at the zoom bucket's resolution, which update() invalidates
+	if (itemBase->itemType() == ModelPart::Wire) return;  // lines are cheaper to draw than to cache
+	if (itemBase->cacheMode() == QGraphicsItem::DeviceCoordinateCache) return;  // being dragged, see setDragCache
+
+	itemBase->setLevelOfDetailCache(scale);
+}
+
+void SketchWidget::updateLevelOfDetail() {
+	double scale = levelOfDetailScale();
+	if (scale == m_levelOfDetailScale) return;
+
+	m_levelOfDetailScale = scale;
+	Q_FOREACH (QGraphicsItem * item, scene()->items()) {
+		auto * itemBase = dynamic_cast<ItemBase *>(item);
+		if (!itemBase) continue;
+
+		applyLevelOfDetail(itemBase, scale);
+	}
+}
+
 void SketchWidget::mouseReleaseEvent(QMouseEvent *event) {
 	//setRenderHint(QPainter::Antialiasing, true);
 
 	//DebugDialog::debug("sketch mouse release event");
 
 	m_draggingBendpoint = false;
+	enableDragConnectorIndex(false);
+	setDragCache(false);
 	if (m_movingByArrow) return;
 
 	m_alignmentItem = nullptr;
@@ -3303,6 +3434,7 @@ void SketchWidget::mouseReleaseEvent(QMouseEvent *event) {
 
 bool SketchWidget::checkMoved(bool wait)
 {
+	setDragCache(false);
 	if (m_moveEventCount == 0) {
 		return false;
 	}
@@ -7695,38 +7827,95 @@ void SketchWidget::drawBackground( QPainter * painter, const QRectF & rect )
 		int intGridSize = static_cast<int>(gridSize * 10000);
 
 		if (intGridSize > 0 && (rect.width() / gridSize < 1024) && (rect.height() / gridSize < 1024)) {
-			double left = static_cast<int>(rect.left() * 10000) - (static_cast<int>(rect.left() * 10000) % intGridSize);
-			left /= 10000;
-			double top = static_cast<int>(rect.top() * 10000) - (static_cast<int>(rect.top() * 10000) % intGridSize);
-			top /= 10000;
-
-			QVarLengthArray<QLineF, 256> linesX;
-			for (double x = left; x < rect.right(); x += gridSize) {
-				linesX.append(QLineF(x, rect.top(), x, rect.bottom()));
+			// fill with a cached tile of grid cells instead of stroking every line on each paint;
+			// the brush is anchored at the scene origin, so the cells stay on the snap grid while panning
+			double deviceScale = painter->worldTransform().mapRect(QRectF(0, 0, 1, 1)).width();
+			QBrush brush = gridBrush(gridSize, deviceScale);
+			if (brush.style() != Qt::NoBrush) {
+				painter->save();
+				painter->setRenderHint(QPainter::SmoothPixmapTransform, false);
+				painter->fillRect(rect, brush);
+				painter->restore();
 			}
+		}
+	}
+}
 
-			QVarLengthArray<QLineF, 256> linesY;
-			for (double  y = top; y < rect.bottom(); y += gridSize) {
-				linesY.append(QLineF(rect.left(), y, rect.right(), y));
-			}
+QBrush SketchWidget::gridBrush(double gridSize, double deviceScale)
+{
+	double cellPixels = gridSize * deviceScale;
+	if (cellPixels <= 0) return QBrush();
 
-			//DebugDialog::debug(QString("lines %1 %2").arg(linesX.count()).arg(linesY.count()));
+	// the tile holds whole cells and is at most a pixel short of their exact width, so each tile pixel
+	// covers one device pixel or slightly more and no grid line is skipped when the brush is sampled
+	int cells = qMax(1, qCeil(GridTilePixels / cellPixels));
+	int tilePixels = qMax(1, qFloor(cells * cellPixels));
+	QString key = QString("%1 %2 %3").arg(cells).arg(tilePixels).arg(m_gridColor.rgba());
+	if (key != m_gridTileKey) {
+		m_gridTileKey = key;
+		m_gridTile = QPixmap(tilePixels, tilePixels);
+		m_gridTile.fill(Qt::transparent);
 
-			QPen pen;
-			pen.setColor(m_gridColor);
-			pen.setWidth(0);
-			pen.setCosmetic(true);
-			//pen.setStyle(Qt::DotLine);
-			//QVector<double> dashes;                   // removed dash pattern at forum suggestion: http://fritzing.org/forum/thread/855
-			//dashes << 1 << 1;
-			//pen.setDashPattern(dashes);
-			painter->save();
-			painter->setPen(pen);
-			painter->drawLines(linesX.data(), linesX.size());
-			painter->drawLines(linesY.data(), linesY.size());
-			painter->restore();
+		QPen pen;
+		pen.setColor(m_gridColor);
+		pen.setWidth(0);
+		pen.setCosmetic(true);
+		//pen.setStyle(Qt::DotLine);
+		//QVector<double> dashes;                   // removed dash pattern at forum suggestion: http://fritzing.org/forum/thread/855
+		//dashes << 1 << 1;
+		//pen.setDashPattern(dashes);
+		QPainter tilePainter(&m_gridTile);
+		tilePainter.setPen(pen);
+		for (int i = 0; i < cells; i++) {
+			int p = qMin(tilePixels - 1, qRound(i * tilePixels / static_cast<double>(cells)));
+			tilePainter.drawLine(p, 0, p, tilePixels - 1);
+		}
+		for (int i = 0; i < cells; i++) {
+			int p = qMin(tilePixels - 1, qRound(i * tilePixels / static_cast<double>(cells)));
+			tilePainter.drawLine(0, p, tilePixels - 1, p);
 		}
+		tilePainter.end();
 	}
+
+	QBrush brush(m_gridTile);
+	double tileScale = cells * gridSize / tilePixels;
+	brush.setTransform(QTransform::fromScale(tileScale, tileScale));
+	return brush;
+}
+
+QString SketchWidget::benchmarkPan(int frames)
+{
+	// developer hook behind -panbench: at the fitted zoom and zoomed out four and sixteen times further,
+	// render the view into an image frame by frame while moving it sideways, and report the time per frame
+	if (frames <= 0) return QString();
+
+	QImage image(PanBenchmarkSize, QImage::Format_ARGB32_Premultiplied);
+	QPainter painter(&image);
+
+	double fitZoom = fitInWindow();
+	QStringList results;
+	QList<double> zooms;
+	zooms << fitZoom << fitZoom / 4 << fitZoom / 16;
+	Q_FOREACH (double zoom, zooms) {
+		absoluteZoom(zoom);
+
+		QElapsedTimer elapsedTimer;
+		elapsedTimer.start();
+		for (int i = 0; i < frames; i++) {
+			QRect source(QPoint(i * PanBenchmarkStep, 0), PanBenchmarkSize);
+			render(&painter, QRectF(image.rect()), source);
+		}
+		qint64 elapsed = elapsedTimer.elapsed();
+
+		results << QString("zoom %1%: %2 ms/frame")
+		        .arg(zoom, 0, 'f', 1)
+		        .arg(elapsed / static_cast<double>(frames), 0, 'f', 2);
+	}
+
+	painter.end();
+	fitInWindow();
+
+	return QString("%1: %2 frames, %3").arg(viewName()).arg(frames).arg(results.join(", "));
 }
 
 void SketchWidget::drawForeground ( QPainter * painter, const QRectF & rect ) {
@@ -7885,6 +8074,8 @@ void SketchWidget::setProp(long itemID, const QString & prop, const QString & va
 	ItemBase * item = findItem(itemID);
 	if (!item) return;
 
+	// a property can change what a part's svg normalizes to without changing the key
+	SvgFragmentCache::invalidate(item->moduleID());
 	item->setProp(prop, value);
 	if (redraw) {
 		viewItemInfo(item);
@@ -8694,15 +8885,7 @@ void SketchWidget::collectAllNets(
 		ViewGeometry::WireFlags skipFlags,
 		bool skipBuses)
 {
-	// get the set of all connectors in the sketch
-	QList<ConnectorItem *> allConnectors;
-	Q_FOREACH (QGraphicsItem * item, scene()->items()) {
-		auto * connectorItem = dynamic_cast<ConnectorItem *>(item);
-		if (!connectorItem) continue;
-		if (!bothSides && connectorItem->attachedToViewLayerID() == ViewLayer::Copper1) continue;
-
-		allConnectors.append(connectorItem);
-	}
+	QList<ConnectorItem *> allConnectors = collectNetConnectors(bothSides);
 
 	// find all the nets and make a list of nodes (i.e. part ConnectorItems) for each net
 	while (allConnectors.count() > 0) {
@@ -8723,64 +8906,154 @@ void SketchWidget::collectAllNets(
 			allConnectors.removeOne(ci);
 		}
 
-		if (!includeSingletons && (connectorItems.count() <= 1)) {
+		auto * partConnectorItems = collectNetParts(connectorItems, indexer, includeSingletons, useSuperpart);
+		if (partConnectorItems) {
+			allPartConnectorItems.append(partConnectorItems);
+		}
+	}
+}
+
+void SketchWidget::collectAllNets(
+		QHash<ConnectorItem *, int> & indexer,
+		QList< QList<class ConnectorItem *>* > & allPartConnectorItems,
+		QHash<ConnectorItem *, int> & splitIndexer,
+		QList< QList<class ConnectorItem *>* > & splitPartConnectorItems,
+		bool includeSingletons,
+		bool bothSides,
+		bool useSuperpart)
+{
+	// the nets as skipBuses == false finds them, plus the same nets split wherever only a part's bus joins them
+	// (as skipBuses == true finds them). A net without a part bus is the same either way, so only bused nets
+	// are walked a second time.
+	QList<ConnectorItem *> allConnectors = collectNetConnectors(bothSides);
+	QSet<ConnectorItem *> startConnectors(allConnectors.begin(), allConnectors.end());
+
+	while (allConnectors.count() > 0) {
+		ConnectorItem * connectorItem = allConnectors.takeFirst();
+		QList<ConnectorItem *> connectorItems;
+		connectorItems.append(connectorItem);
+		ConnectorItem::collectEqualPotential(connectorItems, bothSides, ViewGeometry::NoFlag, false);
+		if (connectorItems.count() <= 0) {
 			continue;
 		}
 
-		auto * partConnectorItems = new QList<ConnectorItem *>;
-		ConnectorItem::collectParts(connectorItems, *partConnectorItems, includeSymbols(), ViewLayer::NewTopAndBottom);
+		bool bused = false;
+		Q_FOREACH (ConnectorItem * ci, connectorItems) {
+			allConnectors.removeOne(ci);
+			if (ci->bus() && ci->attachedToItemType() != ModelPart::Wire) {
+				bused = true;
+			}
+		}
 
-		for (int i = partConnectorItems->count() - 1; i >= 0; i--) {
-			bool shouldRemove = false;
-			auto * item = partConnectorItems->at(i)->attachedTo();
+		auto * partConnectorItems = collectNetParts(connectorItems, indexer, includeSingletons, useSuperpart);
+		if (partConnectorItems) {
+			allPartConnectorItems.append(partConnectorItems);
+		}
 
-			if (!item->isEverVisible()) {
-				if (!useSuperpart || item->subparts().isEmpty()) {
-					shouldRemove = true;
+		if (!bused) {
+			if (partConnectorItems) {
+				Q_FOREACH (ConnectorItem * ci, *partConnectorItems) {
+					splitIndexer.insert(ci, splitIndexer.count());
 				}
+				splitPartConnectorItems.append(new QList<ConnectorItem *>(*partConnectorItems));
 			}
+			continue;
+		}
 
-			if (useSuperpart && !shouldRemove && item->superpart()) {
-				shouldRemove = true;
+		// split walks only start where a skipBuses walk could, so the split nets have the same members
+		QList<ConnectorItem *> busedConnectors;
+		Q_FOREACH (ConnectorItem * ci, connectorItems) {
+			if (startConnectors.contains(ci)) {
+				busedConnectors.append(ci);
+			}
+		}
+		while (busedConnectors.count() > 0) {
+			QList<ConnectorItem *> splitItems;
+			splitItems.append(busedConnectors.takeFirst());
+			ConnectorItem::collectEqualPotential(splitItems, bothSides, ViewGeometry::NoFlag, true);
+			Q_FOREACH (ConnectorItem * ci, splitItems) {
+				busedConnectors.removeOne(ci);
+			}
+
+			auto * splitConnectorItems = collectNetParts(splitItems, splitIndexer, includeSingletons, useSuperpart);
+			if (splitConnectorItems) {
+				splitPartConnectorItems.append(splitConnectorItems);
 			}
+		}
+	}
+}
+
+QList<ConnectorItem *> SketchWidget::collectNetConnectors(bool bothSides) {
+	// get the set of all connectors in the sketch
+	QList<ConnectorItem *> allConnectors;
+	Q_FOREACH (QGraphicsItem * item, scene()->items()) {
+		auto * connectorItem = dynamic_cast<ConnectorItem *>(item);
+		if (!connectorItem) continue;
+		if (!bothSides && connectorItem->attachedToViewLayerID() == ViewLayer::Copper1) continue;
+
+		allConnectors.append(connectorItem);
+	}
+	return allConnectors;
+}
+
+QList<ConnectorItem *> * SketchWidget::collectNetParts(QList<ConnectorItem *> & connectorItems, QHash<ConnectorItem *, int> & indexer, bool includeSingletons, bool useSuperpart) {
+	if (!includeSingletons && (connectorItems.count() <= 1)) {
+		return nullptr;
+	}
 
-			if (shouldRemove) {
-				partConnectorItems->removeAt(i);
+	auto * partConnectorItems = new QList<ConnectorItem *>;
+	ConnectorItem::collectParts(connectorItems, *partConnectorItems, includeSymbols(), ViewLayer::NewTopAndBottom);
+
+	for (int i = partConnectorItems->count() - 1; i >= 0; i--) {
+		bool shouldRemove = false;
+		auto * item = partConnectorItems->at(i)->attachedTo();
+
+		if (!item->isEverVisible()) {
+			if (!useSuperpart || item->subparts().isEmpty()) {
+				shouldRemove = true;
 			}
 		}
 
-		if ((partConnectorItems->count() <= 0) || (!includeSingletons && (partConnectorItems->count() <= 1))) {
-			delete partConnectorItems;
-			continue;
+		if (useSuperpart && !shouldRemove && item->superpart()) {
+			shouldRemove = true;
 		}
 
-		Q_FOREACH (ConnectorItem * ci, *partConnectorItems) {
-			//if (partConnectorItems->count(ci) > 1) {
-			//DebugDialog::debug("collect Parts bug");
-			//}
-			if (!connectorItems.contains(ci)) {
-				// crossed layer: toss it
-				//DebugDialog::debug(QString("not in equal potential '%1' '%2' %3")
-				//	.arg(ci->connectorSharedName())
-				//	.arg(ci->attachedToInstanceTitle())
-				//	.arg(ci->attachedToViewLayerID()));
-				continue;
-			}
-			//if (indexer.keys().contains(ci)) {
-			//DebugDialog::debug(QString("connector item already indexed %1 %2").arg(ci->connectorSharedName()).arg(ci->attachedToInstanceTitle()));
-			//}
-			//int c = indexer.count();
-			//DebugDialog::debug(QString("insert indexer %1 '%2' '%3' %4")
-			//.arg(c)
-			//.arg(ci->connectorSharedName())
-			//.arg(ci->attachedToInstanceTitle())
-			//.arg(ci->attachedToViewLayerID()));
-			indexer.insert(ci, indexer.count());
+		if (shouldRemove) {
+			partConnectorItems->removeAt(i);
 		}
+	}
 
-		//DebugDialog::debug("________________");
-		allPartConnectorItems.append(partConnectorItems);
+	if ((partConnectorItems->count() <= 0) || (!includeSingletons && (partConnectorItems->count() <= 1))) {
+		delete partConnectorItems;
+		return nullptr;
+	}
+
+	Q_FOREACH (ConnectorItem * ci, *partConnectorItems) {
+		//if (partConnectorItems->count(ci) > 1) {
+		//DebugDialog::debug("collect Parts bug");
+		//}
+		if (!connectorItems.contains(ci)) {
+			// crossed layer: toss it
+			//DebugDialog::debug(QString("not in equal potential '%1' '%2' %3")
+			//	.arg(ci->connectorSharedName())
+			//	.arg(ci->attachedToInstanceTitle())
+			//	.arg(ci->attachedToViewLayerID()));
+			continue;
+		}
+		//if (indexer.keys().contains(ci)) {
+		//DebugDialog::debug(QString("connector item already indexed %1 %2").arg(ci->connectorSharedName()).arg(ci->attachedToInstanceTitle()));
+		//}
+		//int c = indexer.count();
+		//DebugDialog::debug(QString("insert indexer %1 '%2' '%3' %4")
+		//.arg(c)
+		//.arg(ci->connectorSharedName())
+		//.arg(ci->attachedToInstanceTitle())
+		//.arg(ci->attachedToViewLayerID()));
+		indexer.insert(ci, indexer.count());
 	}
+
+	//DebugDialog::debug("________________");
+	return partConnectorItems;
 }
 
 ViewLayer::ViewLayerPlacement SketchWidget::getViewLayerPlacement(ModelPart * modelPart, QDomElement & instance, QDomElement & view, ViewGeometry & viewGeometry)
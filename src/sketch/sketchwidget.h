@@ -41,6 +41,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../utils/misc.h"
 #include "../utils/graphutils.h"
 #include "../commands.h"
+#include "../connectors/connectorindex.h"
 
 #include "renderthing.h"
 #include "swapthing.h"
@@ -121,6 +122,7 @@ public:
 	void bringToFront();
 	void alignItems(Qt::Alignment);
 	double fitInWindow();
+	QString benchmarkPan(int frames);
 	QRectF calculateVisibleItemsBoundingRect();
 	void adjustSceneRect(const QRectF &itemsRect, qreal viewMarginFactor);
 	void rotateX(double degrees, bool rubberBandLegEnabled, ItemBase * originatingItem);
@@ -264,6 +266,14 @@ public:
 			bool useSuperpart,
 			ViewGeometry::WireFlags skipFlag = ViewGeometry::NoFlag,
 			bool skipBuses = false);
+	void collectAllNets(
+			QHash<class ConnectorItem *, int> & indexer,
+			QList< QList<class ConnectorItem *>* > & allPartConnectorItems,
+			QHash<class ConnectorItem *, int> & splitIndexer,
+			QList< QList<class ConnectorItem *>* > & splitPartConnectorItems,
+			bool includeSingletons,
+			bool bothSides,
+			bool useSuperpart);
 	virtual bool routeBothSides();
 	virtual void changeLayerForCommand(long id, double z, ViewLayer::ViewLayerID viewLayerID);
 	void ratsnestConnect(ConnectorItem * connectorItem, bool connect);
@@ -305,6 +315,7 @@ public:
 	void setGroundFillSeedForCommand(long id, const QString & connectorID, bool seed);
 	void setWireExtrasForCommand(long id, QDomElement &);
 	void resolveTemporary(bool, ItemBase *);
+	ConnectorIndex * dragConnectorIndex();
 	virtual bool sameElectricalLayer2(ViewLayer::ViewLayerID, ViewLayer::ViewLayerID);
 	void deleteMiddle(QSet<ItemBase *> & deletedItems, QUndoCommand * parentCommand);
 	void setPasting(bool);
@@ -335,6 +346,8 @@ public:
 
 protected:
 	void adjustSceneRect(double zoomFactor, const QRectF &targetRect);
+	QList<class ConnectorItem *> collectNetConnectors(bool bothSides);
+	QList<class ConnectorItem *> * collectNetParts(QList<class ConnectorItem *> & connectorItems, QHash<class ConnectorItem *, int> & indexer, bool includeSingletons, bool useSuperpart);
 	void dragEnterEvent(QDragEnterEvent *);
 	bool dragEnterEventAux(QDragEnterEvent *);
 	bool setDroppingItemAndOffset(const QPoint & pos, const QPointF & offset, ModelPart * modelPart);
@@ -363,6 +376,11 @@ protected:
 	virtual ViewLayer::ViewLayerID getLabelViewLayerID(ItemBase *);
 	ViewLayer::ViewLayerID getNoteViewLayerID();
 	void dragMoveHighlightConnector(QPoint eventPos);
+	void enableDragConnectorIndex(bool);
+	void setDragCache(bool);
+	double levelOfDetailScale();
+	void applyLevelOfDetail(ItemBase *, double scale);
+	QBrush gridBrush(double gridSize, double deviceScale);
 
 	void addToScene(ItemBase * item, ViewLayer::ViewLayerID viewLayerID);
 	ConnectorItem * findConnectorItem(ItemBase * item, const QString & connectorID, ViewLayer::ViewLayerPlacement);
@@ -422,7 +440,7 @@ protected:
 	virtual void setWireVisible(Wire *);
 	bool matchesLayer(ModelPart * modelPart);
 
-	QByteArray removeOutsideConnections(const QByteArray & itemData, QList<long> & modelIndexes);
+	bool removeOutsideConnections(const QByteArray & itemData, QList<long> & modelIndexes, QDomDocument &);
 	void addWireExtras(long newID, QDomElement & view, QUndoCommand * parentCommand);
 	virtual const QString & hoverEnterWireConnectorMessage(QGraphicsSceneHoverEvent * event, ConnectorItem * item);
 	virtual const QString & hoverEnterPartConnectorMessage(QGraphicsSceneHoverEvent * event, ConnectorItem * item);
@@ -578,6 +596,7 @@ Q_SIGNALS:
 	void undoSignal();
 
 protected Q_SLOTS:
+	void updateLevelOfDetail();
 	void itemAddedSlot(ModelPart *, ItemBase *, ViewLayer::ViewLayerPlacement, const ViewGeometry &, long id, SketchWidget * dropOrigin);
 	void itemDeletedSlot(long id);
 	void clearSelectionSlot();
@@ -719,10 +738,16 @@ protected:
 	double m_arrowTotalX = 0.0;
 	double m_arrowTotalY = 0.0;
 	bool m_movingByMouse = false;
+	bool m_dragConnectorIndexEnabled = false;
+	ConnectorIndex m_dragConnectorIndex;
+	QList< QPointer<ItemBase> > m_dragCachedItems;
+	double m_levelOfDetailScale = 0;
 	bool m_alignToGrid = true;
 	bool m_showGrid = true;
 	double m_gridSizeInches = 0.0;
 	QString m_gridSizeText;
+	QPixmap m_gridTile;
+	QString m_gridTileKey;
 	QPointer<ItemBase> m_alignmentItem;
 	QPointer<ItemBase> m_originatingItem;
 	QPointF m_alignmentStartPoint;
@@ -763,10 +788,14 @@ public:
 	static ViewLayer::ViewLayerID defaultConnectorLayer(ViewLayer::ViewID viewId);
 	static constexpr int PropChangeDelay = 100;
 	static bool m_blockUI;
+	static bool clipboardDocument(const class QMimeData *, QDomDocument &);
 
 protected:
 	static constexpr int MoveAutoScrollThreshold = 5;
 	static constexpr int DragAutoScrollThreshold = 10;
+	static QDomDocument ClipboardDocument;
+	static QByteArray ClipboardID;
+	static qint64 ClipboardCount;
 };
 
 #endif
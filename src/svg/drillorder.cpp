@@ -0,0 +1,116 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "drillorder.h"
+
+#include <QVector>
+#include <qmath.h>
+#include <algorithm>
+
+static constexpr int MaxTwoOptPasses = 32;
+static constexpr int TwoOptWindow = 400;		// limits a pass to O(n * window) on panels with thousands of hits
+
+static inline double distance(const QPoint & p, const QPoint & q) {
+	return qSqrt(double(p.x() - q.x()) * (p.x() - q.x()) + double(p.y() - q.y()) * (p.y() - q.y()));
+}
+
+QList<QPoint> DrillOrder::optimize(const QList<QPoint> & hits, const QPoint & start)
+{
+	if (hits.count() < 3) {
+		return nearestNeighbour(hits, start);
+	}
+
+	QList<QPoint> tour = nearestNeighbour(hits, start);
+	twoOpt(tour, start);
+	return tour;
+}
+
+double DrillOrder::travel(const QList<QPoint> & hits, const QPoint & start)
+{
+	double total = 0;
+	QPoint current = start;
+	Q_FOREACH (QPoint hit, hits) {
+		total += distance(current, hit);
+		current = hit;
+	}
+	return total;
+}
+
+QList<QPoint> DrillOrder::nearestNeighbour(const QList<QPoint> & hits, const QPoint & start)
+{
+	QList<QPoint> remaining(hits);
+	QList<QPoint> tour;
+	tour.reserve(hits.count());
+	QPoint current = start;
+	while (!remaining.isEmpty()) {
+		int best = 0;
+		double bestDistance = distance(current, remaining.at(0));
+		for (int i = 1; i < remaining.count(); i++) {
+			double d = distance(current, remaining.at(i));
+			if (d < bestDistance) {
+				bestDistance = d;
+				best = i;
+			}
+		}
+
+		current = remaining.at(best);
+		tour.append(current);
+		// order within remaining does not matter, so swap the last one in instead of shifting
+		remaining.swapItemsAt(best, remaining.count() - 1);
+		remaining.removeLast();
+	}
+
+	return tour;
+}
+
+void DrillOrder::twoOpt(QList<QPoint> & tour, const QPoint & start)
+{
+	// path[0] is the fixed head position; reversing path[i..j] swaps edges (i-1, i) and (j, j+1) for (i-1, j) and (i, j+1)
+	QVector<QPoint> path;
+	path.reserve(tour.count() + 1);
+	path.append(start);
+	path.append(tour.toVector());
+	int last = path.count() - 1;
+
+	for (int pass = 0; pass < MaxTwoOptPasses; pass++) {
+		bool improved = false;
+		for (int i = 1; i < last; i++) {
+			int jLimit = qMin(last, i + TwoOptWindow);
+			for (int j = i + 1; j <= jLimit; j++) {
+				double before = distance(path.at(i - 1), path.at(i));
+				double after = distance(path.at(i - 1), path.at(j));
+				if (j < last) {
+					before += distance(path.at(j), path.at(j + 1));
+					after += distance(path.at(i), path.at(j + 1));
+				}
+
+				if (after < before - 1e-9) {
+					std::reverse(path.begin() + i, path.begin() + j + 1);
+					improved = true;
+				}
+			}
+		}
+
+		if (!improved) break;
+	}
+
+	path.removeFirst();
+	tour = QList<QPoint>(path.begin(), path.end());
+}
@@ -0,0 +1,42 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef DRILLORDER_H
+#define DRILLORDER_H
+
+#include <QList>
+#include <QPoint>
+
+class DrillOrder
+{
+	// Orders the hits of one Excellon tool so the drill head travels less:
+	// a nearest-neighbour tour from the head position, then 2-opt until no reversal shortens it.
+	// The tour is open; it ends wherever the last hit is, which is where the next tool starts.
+
+public:
+	static QList<QPoint> optimize(const QList<QPoint> & hits, const QPoint & start);
+	static double travel(const QList<QPoint> & hits, const QPoint & start);
+
+protected:
+	static QList<QPoint> nearestNeighbour(const QList<QPoint> & hits, const QPoint & start);
+	static void twoOpt(QList<QPoint> & tour, const QPoint & start);
+};
+
+#endif
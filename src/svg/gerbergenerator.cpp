@@ -77,7 +77,7 @@ bool pixelsCollide(QImage * image1, QImage * image2, int x1, int y1, int x2, int
 
 ////////////////////////////////////////////
 
-void GerberGenerator::exportToGerber(const QString & prefix, const QString & exportDir, ItemBase * board, PCBSketchWidget * sketchWidget, bool displayMessageBoxes)
+void GerberGenerator::exportToGerber(const QString & prefix, const QString & exportDir, ItemBase * board, PCBSketchWidget * sketchWidget, bool displayMessageBoxes, GerberPanel panel)
 {
 	if (board == nullptr) {
 		int boardCount = 0;
@@ -94,35 +94,38 @@ void GerberGenerator::exportToGerber(const QString & prefix, const QString & exp
 
 	exportPickAndPlace(prefix, exportDir, board, sketchWidget, displayMessageBoxes);
 
+	// each layer is rendered for one board; a panel only repeats it in the output
+	panel.setBoardSize(board->sceneBoundingRect().size() / GraphicsUtils::SVGDPI);
+
 	LayerList viewLayerIDs = ViewLayer::copperLayers(ViewLayer::NewBottom);
-	int copperInvalidCount = doCopper(board, sketchWidget, viewLayerIDs, "Copper0", CopperBottomSuffix, prefix, exportDir, displayMessageBoxes);
+	int copperInvalidCount = doCopper(board, sketchWidget, viewLayerIDs, "Copper0", CopperBottomSuffix, prefix, exportDir, displayMessageBoxes, panel);
 
 	if (sketchWidget->boardLayers() == 2) {
 		viewLayerIDs = ViewLayer::copperLayers(ViewLayer::NewTop);
-		copperInvalidCount += doCopper(board, sketchWidget, viewLayerIDs, "Copper1", CopperTopSuffix, prefix, exportDir, displayMessageBoxes);
+		copperInvalidCount += doCopper(board, sketchWidget, viewLayerIDs, "Copper1", CopperTopSuffix, prefix, exportDir, displayMessageBoxes, panel);
 	}
 
 	LayerList maskLayerIDs = ViewLayer::maskLayers(ViewLayer::NewBottom);
 	QString maskBottom, maskTop;
-	int maskInvalidCount = doMask(maskLayerIDs, "Mask0", MaskBottomSuffix, board, sketchWidget, prefix, exportDir, displayMessageBoxes, maskBottom);
+	int maskInvalidCount = doMask(maskLayerIDs, "Mask0", MaskBottomSuffix, board, sketchWidget, prefix, exportDir, displayMessageBoxes, maskBottom, panel);
 
 	if (sketchWidget->boardLayers() == 2) {
 		maskLayerIDs = ViewLayer::maskLayers(ViewLayer::NewTop);
-		maskInvalidCount += doMask(maskLayerIDs, "Mask1", MaskTopSuffix, board, sketchWidget, prefix, exportDir, displayMessageBoxes, maskTop);
+		maskInvalidCount += doMask(maskLayerIDs, "Mask1", MaskTopSuffix, board, sketchWidget, prefix, exportDir, displayMessageBoxes, maskTop, panel);
 	}
 
 	maskLayerIDs = ViewLayer::maskLayers(ViewLayer::NewBottom);
-	int pasteMaskInvalidCount = doPasteMask(maskLayerIDs, "PasteMask0", PasteMaskBottomSuffix, board, sketchWidget, prefix, exportDir, displayMessageBoxes);
+	int pasteMaskInvalidCount = doPasteMask(maskLayerIDs, "PasteMask0", PasteMaskBottomSuffix, board, sketchWidget, prefix, exportDir, displayMessageBoxes, panel);
 
 	if (sketchWidget->boardLayers() == 2) {
 		maskLayerIDs = ViewLayer::maskLayers(ViewLayer::NewTop);
-		pasteMaskInvalidCount += doPasteMask(maskLayerIDs, "PasteMask1", PasteMaskTopSuffix, board, sketchWidget, prefix, exportDir, displayMessageBoxes);
+		pasteMaskInvalidCount += doPasteMask(maskLayerIDs, "PasteMask1", PasteMaskTopSuffix, board, sketchWidget, prefix, exportDir, displayMessageBoxes, panel);
 	}
 
 	LayerList silkLayerIDs = ViewLayer::silkLayers(ViewLayer::NewTop);
-	int silkInvalidCount = doSilk(silkLayerIDs, "Silk1", SilkTopSuffix, board, sketchWidget, prefix, exportDir, displayMessageBoxes, maskTop);
+	int silkInvalidCount = doSilk(silkLayerIDs, "Silk1", SilkTopSuffix, board, sketchWidget, prefix, exportDir, displayMessageBoxes, maskTop, panel);
 	silkLayerIDs = ViewLayer::silkLayers(ViewLayer::NewBottom);
-	silkInvalidCount += doSilk(silkLayerIDs, "Silk0", SilkBottomSuffix, board, sketchWidget, prefix, exportDir, displayMessageBoxes, maskBottom);
+	silkInvalidCount += doSilk(silkLayerIDs, "Silk0", SilkBottomSuffix, board, sketchWidget, prefix, exportDir, displayMessageBoxes, maskBottom, panel);
 
 	// now do it for the outline/contour
 	LayerList outlineLayerIDs = ViewLayer::outlineLayers();
@@ -143,10 +146,11 @@ void GerberGenerator::exportToGerber(const QString & prefix, const QString & exp
 	SVG2gerber outlineGerber;
 	int outlineInvalidCount = outlineGerber.convert(svgOutline, sketchWidget->boardLayers() == 2, "contour", SVG2gerber::ForOutline, svgSize * GraphicsUtils::StandardFritzingDPI);
 
+	outlineGerber.panelize(panel, SVG2gerber::ForOutline);
 	//DebugDialog::debug(QString("outline output: %1").arg(outlineGerber.getGerber()));
 	saveEnd("contour", exportDir, prefix, OutlineSuffix, displayMessageBoxes, outlineGerber);
 
-	doDrill(board, sketchWidget, prefix, exportDir, displayMessageBoxes);
+	doDrill(board, sketchWidget, prefix, exportDir, displayMessageBoxes, panel);
 
 	if (outlineInvalidCount > 0 || silkInvalidCount > 0 || copperInvalidCount > 0 || (maskInvalidCount != 0) || (pasteMaskInvalidCount != 0)) {
 		QString s;
@@ -161,7 +165,7 @@ void GerberGenerator::exportToGerber(const QString & prefix, const QString & exp
 
 }
 
-int GerberGenerator::doCopper(ItemBase * board, PCBSketchWidget * sketchWidget, LayerList & viewLayerIDs, const QString & copperName, const QString & copperSuffix, const QString & filename, const QString & exportDir, bool displayMessageBoxes)
+int GerberGenerator::doCopper(ItemBase * board, PCBSketchWidget * sketchWidget, LayerList & viewLayerIDs, const QString & copperName, const QString & copperSuffix, const QString & filename, const QString & exportDir, bool displayMessageBoxes, const GerberPanel & panel)
 {
 	bool empty;
 	QString svg = renderTo(viewLayerIDs, board, sketchWidget, empty);
@@ -188,11 +192,11 @@ int GerberGenerator::doCopper(ItemBase * board, PCBSketchWidget * sketchWidget,
 		return 0;
 	}
 
-	return doEnd(svg, sketchWidget->boardLayers(), copperName, SVG2gerber::ForCopper, svgSize * GraphicsUtils::StandardFritzingDPI, exportDir, filename, copperSuffix, displayMessageBoxes);
+	return doEnd(svg, sketchWidget->boardLayers(), copperName, SVG2gerber::ForCopper, svgSize * GraphicsUtils::StandardFritzingDPI, exportDir, filename, copperSuffix, displayMessageBoxes, panel);
 }
 
 
-int GerberGenerator::doSilk(LayerList silkLayerIDs, const QString & silkName, const QString & gerberSuffix, ItemBase * board, PCBSketchWidget * sketchWidget, const QString & filename, const QString & exportDir, bool displayMessageBoxes, const QString & clipString)
+int GerberGenerator::doSilk(LayerList silkLayerIDs, const QString & silkName, const QString & gerberSuffix, ItemBase * board, PCBSketchWidget * sketchWidget, const QString & filename, const QString & exportDir, bool displayMessageBoxes, const QString & clipString, const GerberPanel & panel)
 {
 
 	bool empty;
@@ -225,11 +229,11 @@ int GerberGenerator::doSilk(LayerList silkLayerIDs, const QString & silkName, co
 	//fs2 << svgSilk;
 	//f2.close();
 
-	return doEnd(svgSilk, sketchWidget->boardLayers(), silkName, SVG2gerber::ForSilk, svgSize * GraphicsUtils::StandardFritzingDPI, exportDir, filename, gerberSuffix, displayMessageBoxes);
+	return doEnd(svgSilk, sketchWidget->boardLayers(), silkName, SVG2gerber::ForSilk, svgSize * GraphicsUtils::StandardFritzingDPI, exportDir, filename, gerberSuffix, displayMessageBoxes, panel);
 }
 
 
-int GerberGenerator::doDrill(ItemBase * board, PCBSketchWidget * sketchWidget, const QString & filename, const QString & exportDir, bool displayMessageBoxes)
+int GerberGenerator::doDrill(ItemBase * board, PCBSketchWidget * sketchWidget, const QString & filename, const QString & exportDir, bool displayMessageBoxes, const GerberPanel & panel)
 {
 	LayerList drillLayerIDs;
 	drillLayerIDs << ViewLayer::drillLayers();
@@ -258,10 +262,10 @@ int GerberGenerator::doDrill(ItemBase * board, PCBSketchWidget * sketchWidget, c
 		return 0;
 	}
 
-	return doEnd(svgDrill, sketchWidget->boardLayers(), "drill", SVG2gerber::ForDrill, svgSize * GraphicsUtils::StandardFritzingDPI, exportDir, filename, DrillSuffix, displayMessageBoxes);
+	return doEnd(svgDrill, sketchWidget->boardLayers(), "drill", SVG2gerber::ForDrill, svgSize * GraphicsUtils::StandardFritzingDPI, exportDir, filename, DrillSuffix, displayMessageBoxes, panel);
 }
 
-int GerberGenerator::doMask(LayerList maskLayerIDs, const QString &maskName, const QString & gerberSuffix, ItemBase * board, PCBSketchWidget * sketchWidget, const QString & filename, const QString & exportDir, bool displayMessageBoxes, QString & clipString)
+int GerberGenerator::doMask(LayerList maskLayerIDs, const QString &maskName, const QString & gerberSuffix, ItemBase * board, PCBSketchWidget * sketchWidget, const QString & filename, const QString & exportDir, bool displayMessageBoxes, QString & clipString, const GerberPanel & panel)
 {
 	// don't want these in the mask laqyer
 	QList<ItemBase *> copperLogoItems;
@@ -293,10 +297,10 @@ int GerberGenerator::doMask(LayerList maskLayerIDs, const QString &maskName, con
 
 	clipString = svgMask;
 
-	return doEnd(svgMask, sketchWidget->boardLayers(), maskName, SVG2gerber::ForMask, svgSize * GraphicsUtils::StandardFritzingDPI, exportDir, filename, gerberSuffix, displayMessageBoxes);
+	return doEnd(svgMask, sketchWidget->boardLayers(), maskName, SVG2gerber::ForMask, svgSize * GraphicsUtils::StandardFritzingDPI, exportDir, filename, gerberSuffix, displayMessageBoxes, panel);
 }
 
-int GerberGenerator::doPasteMask(LayerList maskLayerIDs, const QString &maskName, const QString & gerberSuffix, ItemBase * board, PCBSketchWidget * sketchWidget, const QString & filename, const QString & exportDir, bool displayMessageBoxes)
+int GerberGenerator::doPasteMask(LayerList maskLayerIDs, const QString &maskName, const QString & gerberSuffix, ItemBase * board, PCBSketchWidget * sketchWidget, const QString & filename, const QString & exportDir, bool displayMessageBoxes, const GerberPanel & panel)
 {
 	// don't want these in the mask laqyer
 	QList<ItemBase *> copperLogoItems;
@@ -325,15 +329,19 @@ int GerberGenerator::doPasteMask(LayerList maskLayerIDs, const QString &maskName
 		return 0;
 	}
 
-	return doEnd(svgMask, sketchWidget->boardLayers(), maskName, SVG2gerber::ForCopper, svgSize * GraphicsUtils::StandardFritzingDPI, exportDir, filename, gerberSuffix, displayMessageBoxes);
+	// paste is converted like copper, but must not cover the fiducials
+	GerberPanel pastePanel(panel);
+	pastePanel.setFiducials(false);
+	return doEnd(svgMask, sketchWidget->boardLayers(), maskName, SVG2gerber::ForCopper, svgSize * GraphicsUtils::StandardFritzingDPI, exportDir, filename, gerberSuffix, displayMessageBoxes, pastePanel);
 }
 
 int GerberGenerator::doEnd(const QString & svg, int boardLayers, const QString & layerName, SVG2gerber::ForWhy forWhy, QSizeF svgSize,
-                           const QString & exportDir, const QString & prefix, const QString & suffix, bool displayMessageBoxes)
+                           const QString & exportDir, const QString & prefix, const QString & suffix, bool displayMessageBoxes, const GerberPanel & panel)
 {
 	// create mask gerber from svg
 	SVG2gerber gerber;
 	int invalidCount = gerber.convert(svg, boardLayers == 2, layerName, forWhy, svgSize);
+	gerber.panelize(panel, forWhy);
 
 	saveEnd(layerName, exportDir, prefix, suffix, displayMessageBoxes, gerber);
 
@@ -350,11 +358,12 @@ bool GerberGenerator::saveEnd(const QString & layerName, const QString & exportD
 		return false;
 	}
 
-	QTextStream stream(&out);
-	stream << gerber.getGerber();
-	stream.flush();
+	bool result = gerber.write(out);
 	out.close();
-	return true;
+	if (!result) {
+		displayMessage(QObject::tr("%1 layer: unable to save to '%2'").arg(layerName, outname), displayMessageBoxes);
+	}
+	return result;
 
 }
 
@@ -993,7 +1002,7 @@ QString checkMountTechnology(const QString &package)
 	return "SMT";
 }
 
-void GerberGenerator::exportPickAndPlace(const QString & prefix, const QString & exportDir, ItemBase * board, PCBSketchWidget * sketchWidget, bool displayMessageBoxes)
+bool GerberGenerator::exportPickAndPlace(const QString & prefix, const QString & exportDir, ItemBase * board, PCBSketchWidget * sketchWidget, bool displayMessageBoxes)
 {
 	QPointF bottomLeft = board->sceneBoundingRect().bottomLeft();
 	QSet<ItemBase *> itemBases;
@@ -1014,7 +1023,7 @@ void GerberGenerator::exportPickAndPlace(const QString & prefix, const QString &
 	QFile out(outname);
 	if (!out.open(QIODevice::WriteOnly | QIODevice::Text)) {
 		displayMessage(QObject::tr("Unable to save pick and place file: %2").arg(outname), displayMessageBoxes);
-		return;
+		return false;
 	}
 
 	QStringList valueKeys;
@@ -1086,7 +1095,9 @@ void GerberGenerator::exportPickAndPlace(const QString & prefix, const QString &
 		stream.flush();
 	}
 
+	bool ok = stream.status() == QTextStream::Ok && out.error() == QFileDevice::NoError;
 	out.close();
+	return ok;
 }
 
 void GerberGenerator::handleDonuts(QDomElement & root1, QMultiHash<long, ConnectorItem *> & treatAsCircle) {
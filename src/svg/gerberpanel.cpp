@@ -0,0 +1,371 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "gerberpanel.h"
+
+#include <QRegularExpression>
+#include <QtMath>
+
+#include <algorithm>
+#include <limits>
+
+static constexpr double FrameWidth = 0.008;
+static constexpr double EdgeTolerance = 0.000001;
+static constexpr double DrillUnits = 10000;		// Excellon coordinates are in 1/10000 inch
+
+static QByteArray gerberCoordinate(double inches, double scale) {
+	return QByteArray::number(qRound64(inches * scale));
+}
+
+static QByteArray drillCoordinate(int value) {
+	QByteArray result = QByteArray::number(qAbs(value)).rightJustified(6, '0');
+	if (value < 0) result.prepend('-');
+	return result;
+}
+
+static QByteArray flash(const QPointF & p, double scale) {
+	return "X" + gerberCoordinate(p.x(), scale) + "Y" + gerberCoordinate(p.y(), scale) + "D03*\n";
+}
+
+static int nextIndex(const QByteArray & header, const QRegularExpression & expression, int minimum, int limit = std::numeric_limits<int>::max()) {
+	int result = minimum;
+	QRegularExpressionMatchIterator it = expression.globalMatch(QString::fromUtf8(header));
+	while (it.hasNext()) {
+		int index = it.next().captured(1).toInt();
+		if (index < limit) result = qMax(result, index + 1);
+	}
+	return result;
+}
+
+////////////////////////////////////////////
+
+GerberPanel::GerberPanel(int columns, int rows, double gap, double rail) :
+	m_columns(qMax(1, columns)),
+	m_rows(qMax(1, rows)),
+	m_gap(qMax(0.0, gap)),
+	m_rail(qMax(0.0, rail))
+{
+}
+
+bool GerberPanel::isEmpty() const {
+	return m_boardSize.isEmpty() || (m_columns * m_rows <= 1 && m_rail <= 0);
+}
+
+int GerberPanel::columns() const {
+	return m_columns;
+}
+
+int GerberPanel::rows() const {
+	return m_rows;
+}
+
+void GerberPanel::setBoardSize(const QSizeF & size) {
+	m_boardSize = size;
+}
+
+void GerberPanel::setFiducials(bool fiducials) {
+	m_fiducials = fiducials;
+}
+
+void GerberPanel::setMouseBites(bool mouseBites) {
+	m_mouseBites = mouseBites;
+}
+
+QPointF GerberPanel::boardOffset(int column, int row) const {
+	return QPointF(column * (m_boardSize.width() + m_gap), row * (m_boardSize.height() + m_gap));
+}
+
+QRectF GerberPanel::panelRect() const {
+	double margin = m_rail > 0 ? m_gap + m_rail : 0;
+	QPointF corner = boardOffset(m_columns - 1, m_rows - 1) + QPointF(m_boardSize.width(), m_boardSize.height());
+	return QRectF(0, -margin, corner.x(), corner.y() + margin + margin);
+}
+
+QList<QPointF> GerberPanel::fiducials() const {
+	// three on the rails, asymmetric so the assembler can tell a rotated panel
+	QList<QPointF> points;
+	if (!m_fiducials || m_rail < FiducialMaskDiameter * 2) return points;
+
+	QRectF panel = panelRect();
+	double inset = qMax(m_rail, FiducialMaskDiameter * 2);
+	double bottom = panel.top() + m_rail / 2;
+	double top = panel.bottom() - m_rail / 2;
+	points << QPointF(panel.left() + inset, bottom) << QPointF(panel.right() - inset, bottom) << QPointF(panel.left() + inset, top);
+	return points;
+}
+
+QList<GerberPanel::Tab> GerberPanel::tabs() const {
+	// one tab at the middle of every board edge that faces another board or a rail
+	QList<Tab> tabs;
+	double w = m_boardSize.width();
+	double h = m_boardSize.height();
+	for (int row = 0; row < m_rows; row++) {
+		for (int column = 0; column < m_columns; column++) {
+			QPointF offset = boardOffset(column, row);
+			if (column + 1 < m_columns) {
+				tabs.append(Tab { QPointF(offset.x() + w + m_gap / 2, offset.y() + h / 2), false, true, true });
+			}
+			if (row + 1 < m_rows) {
+				tabs.append(Tab { QPointF(offset.x() + w / 2, offset.y() + h + m_gap / 2), true, true, true });
+			}
+			if (m_rail > 0 && row == 0) {
+				tabs.append(Tab { QPointF(offset.x() + w / 2, offset.y() - m_gap / 2), true, false, true });
+			}
+			if (m_rail > 0 && row + 1 == m_rows) {
+				tabs.append(Tab { QPointF(offset.x() + w / 2, offset.y() + h + m_gap / 2), true, true, false });
+			}
+		}
+	}
+	return tabs;
+}
+
+QList<QPointF> GerberPanel::mouseBiteHoles() const {
+	// a row of small holes along the board edge at each tab, so the tab snaps flush with the board
+	QList<QPointF> holes;
+	if (!m_mouseBites) return holes;
+
+	int count = qFloor(TabWidth / MouseBitePitch);
+	double start = -(count - 1) * MouseBitePitch / 2;
+	Q_FOREACH (Tab tab, tabs()) {
+		QList<double> edges;
+		if (tab.edgeBefore) edges << -m_gap / 2;
+		if (tab.edgeAfter) edges << m_gap / 2;
+		Q_FOREACH (double edge, edges) {
+			for (int i = 0; i < count; i++) {
+				double along = start + i * MouseBitePitch;
+				if (tab.horizontal) holes << tab.center + QPointF(along, edge);
+				else holes << tab.center + QPointF(edge, along);
+			}
+		}
+	}
+	return holes;
+}
+
+QList<QLineF> GerberPanel::cutLines() const {
+	// the milled outline: the edges of every board and of the rails, broken where a tab bridges the gap,
+	// plus the two sides of each tab; like the tabs, it takes each board to fill its bounding rectangle
+	QList<QLineF> edges;
+	for (int row = 0; row < m_rows; row++) {
+		for (int column = 0; column < m_columns; column++) {
+			QRectF board(boardOffset(column, row), m_boardSize);
+			edges << QLineF(board.topLeft(), board.topRight()) << QLineF(board.bottomLeft(), board.bottomRight())
+			      << QLineF(board.topLeft(), board.bottomLeft()) << QLineF(board.topRight(), board.bottomRight());
+		}
+	}
+	if (m_rail > 0) {
+		QRectF panel = panelRect();
+		edges << QLineF(panel.left(), panel.top() + m_rail, panel.right(), panel.top() + m_rail)
+		      << QLineF(panel.left(), panel.bottom() - m_rail, panel.right(), panel.bottom() - m_rail);
+	}
+
+	QList<Tab> tabList = tabs();
+	QList<QLineF> lines;
+	Q_FOREACH (QLineF edge, edges) {
+		bool alongX = edge.y1() == edge.y2();
+		double position = alongX ? edge.y1() : edge.x1();
+		auto append = [&](double from, double to) {
+			if (to <= from) return;
+			lines << (alongX ? QLineF(from, position, to, position) : QLineF(position, from, position, to));
+		};
+
+		// a tab meets the edge when one side of its gap lies on the edge
+		QList<double> breaks;
+		double start = alongX ? edge.x1() : edge.y1();
+		double end = alongX ? edge.x2() : edge.y2();
+		Q_FOREACH (Tab tab, tabList) {
+			if (tab.horizontal != alongX) continue;
+
+			double across = alongX ? tab.center.y() : tab.center.x();
+			double along = alongX ? tab.center.x() : tab.center.y();
+			if (qAbs(qAbs(across - position) - m_gap / 2) > EdgeTolerance) continue;
+			if (along <= start || along >= end) continue;
+
+			breaks << along;
+		}
+		std::sort(breaks.begin(), breaks.end());
+
+		double from = start;
+		Q_FOREACH (double along, breaks) {
+			append(from, along - TabWidth / 2);
+			from = along + TabWidth / 2;
+		}
+		append(from, end);
+	}
+
+	if (m_gap > 0) {
+		Q_FOREACH (Tab tab, tabList) {
+			QPointF c = tab.center;
+			if (tab.horizontal) {
+				lines << QLineF(c.x() - TabWidth / 2, c.y() - m_gap / 2, c.x() - TabWidth / 2, c.y() + m_gap / 2)
+				      << QLineF(c.x() + TabWidth / 2, c.y() - m_gap / 2, c.x() + TabWidth / 2, c.y() + m_gap / 2);
+			}
+			else {
+				lines << QLineF(c.x() - m_gap / 2, c.y() - TabWidth / 2, c.x() + m_gap / 2, c.y() - TabWidth / 2)
+				      << QLineF(c.x() - m_gap / 2, c.y() + TabWidth / 2, c.x() + m_gap / 2, c.y() + TabWidth / 2);
+			}
+		}
+	}
+
+	return lines;
+}
+
+void GerberPanel::apply(QByteArray & header, QByteArray & paths, SVG2gerber::ForWhy forWhy) const {
+	if (isEmpty()) return;
+
+	if (forWhy == SVG2gerber::ForDrill) {
+		applyDrill(header, paths);
+	}
+	else {
+		applyImage(header, paths, forWhy);
+	}
+}
+
+void GerberPanel::applyImage(QByteArray & header, QByteArray & paths, SVG2gerber::ForWhy forWhy) const {
+	static const QRegularExpression formatFinder("%FSLAX\\d(\\d)Y");
+	static const QRegularExpression apertureFinder("%ADD(\\d+)");
+
+	QRegularExpressionMatch match = formatFinder.match(QString::fromUtf8(header));
+	if (!match.hasMatch()) return;
+
+	double scale = qPow(10, match.captured(1).toInt());
+	int footer = paths.lastIndexOf("G04 End of");
+	if (footer < 0) footer = paths.lastIndexOf("M02*");
+	if (footer < 0) footer = paths.size();
+
+	QByteArray result;
+	if (forWhy == SVG2gerber::ForOutline) {
+		// the board's own contour would be milled straight through the tabs, so it is replaced by cutLines()
+	}
+	else if (m_columns * m_rows > 1) {
+		result += QString("%SRX%1Y%2I%3J%4*%\n")
+		          .arg(m_columns).arg(m_rows)
+		          .arg(m_boardSize.width() + m_gap, 0, 'f')
+		          .arg(m_boardSize.height() + m_gap, 0, 'f').toUtf8();
+		result += paths.left(footer);
+		if (!result.endsWith('\n')) result += '\n';
+		result += "%SR*%\n";
+	}
+	else {
+		result += paths.left(footer);
+	}
+
+	int dcode = nextIndex(header, apertureFinder, 10);
+	QList<QPointF> fiducialPoints = fiducials();
+	if ((forWhy == SVG2gerber::ForCopper || forWhy == SVG2gerber::ForMask) && !fiducialPoints.isEmpty()) {
+		double diameter = forWhy == SVG2gerber::ForMask ? FiducialMaskDiameter : FiducialDiameter;
+		header += QString("%ADD%1C,%2*%\n").arg(dcode).arg(diameter, 0, 'f').toUtf8();
+		result += QString("D%1*\n").arg(dcode).toUtf8();
+		Q_FOREACH (QPointF p, fiducialPoints) {
+			result += flash(p, scale);
+		}
+	}
+	else if (forWhy == SVG2gerber::ForOutline) {
+		header += QString("%ADD%1C,%2*%\n").arg(dcode).arg(FrameWidth, 0, 'f').toUtf8();
+		result += QString("G01*\nD%1*\n").arg(dcode).toUtf8();
+		Q_FOREACH (QLineF line, cutLines()) {
+			result += "X" + gerberCoordinate(line.x1(), scale) + "Y" + gerberCoordinate(line.y1(), scale) + "D02*\n";
+			result += "X" + gerberCoordinate(line.x2(), scale) + "Y" + gerberCoordinate(line.y2(), scale) + "D01*\n";
+		}
+
+		if (m_rail > 0) {
+			QRectF panel = panelRect();
+			QList<QPointF> corners;
+			corners << panel.topLeft() << panel.topRight() << panel.bottomRight() << panel.bottomLeft() << panel.topLeft();
+			for (int i = 0; i < corners.count(); i++) {
+				result += "X" + gerberCoordinate(corners.at(i).x(), scale) + "Y" + gerberCoordinate(corners.at(i).y(), scale);
+				result += i == 0 ? "D02*\n" : "D01*\n";
+			}
+		}
+	}
+
+	result += paths.mid(footer);
+	paths = result;
+}
+
+void GerberPanel::applyDrill(QByteArray & header, QByteArray & paths) const {
+	static const QRegularExpression toolFinder("^T(\\d+)C", QRegularExpression::MultilineOption);
+	static const QRegularExpression platedFinder("^; THROUGH \\(PLATED\\) HOLES START AT T(\\d+)$", QRegularExpression::MultilineOption);
+	static const QRegularExpression selectFinder("^T(\\d+)$");
+	static const QRegularExpression hitFinder("^X(-?\\d+)Y(-?\\d+)$");
+
+	// boards in serpentine order so the head does not fly back across the panel for every row
+	QList<QPoint> offsets;
+	for (int row = 0; row < m_rows; row++) {
+		for (int i = 0; i < m_columns; i++) {
+			int column = (row % 2 == 0) ? i : m_columns - 1 - i;
+			QPointF offset = boardOffset(column, row) * DrillUnits;
+			offsets << QPoint(qRound(offset.x()), qRound(offset.y()));
+		}
+	}
+
+	QByteArray result;
+	QList<QPoint> hits;
+	auto flushHits = [&]() {
+		Q_FOREACH (QPoint offset, offsets) {
+			Q_FOREACH (QPoint hit, hits) {
+				result += "X" + drillCoordinate(hit.x() + offset.x()) + "Y" + drillCoordinate(hit.y() + offset.y()) + "\n";
+			}
+		}
+		hits.clear();
+	};
+
+	// mouse bites must not be plated, so their tool goes after the non-plated tools, below the plated range (see SVG2gerber)
+	QList<QPointF> holes = mouseBiteHoles();
+	int platedIndex = 100;
+	QRegularExpressionMatch platedMatch = platedFinder.match(QString::fromUtf8(header));
+	if (platedMatch.hasMatch()) platedIndex = platedMatch.captured(1).toInt();
+	int tool = nextIndex(header, toolFinder, 1, platedIndex);
+	if (tool >= platedIndex) holes.clear();		// every non-plated tool number is taken
+	if (!holes.isEmpty()) {
+		int insert = header.lastIndexOf("%\n");
+		if (insert < 0) insert = header.size();
+		QRegularExpressionMatchIterator it = toolFinder.globalMatch(QString::fromUtf8(header));
+		while (it.hasNext()) {
+			QRegularExpressionMatch toolMatch = it.next();
+			if (toolMatch.captured(1).toInt() >= platedIndex) {
+				insert = toolMatch.capturedStart(0);
+				break;
+			}
+		}
+		header.insert(insert, QString("T%1C%2\n").arg(tool).arg(MouseBiteDiameter, 0, 'f').toUtf8());
+	}
+
+	Q_FOREACH (QByteArray line, paths.split('\n')) {
+		QRegularExpressionMatch match = hitFinder.match(QString::fromUtf8(line));
+		if (match.hasMatch()) {
+			hits << QPoint(match.captured(1).toInt(), match.captured(2).toInt());
+			continue;
+		}
+
+		flushHits();
+		QRegularExpressionMatch selectMatch = selectFinder.match(QString::fromUtf8(line));
+		if (!holes.isEmpty() && selectMatch.hasMatch() && (line == "T00" || selectMatch.captured(1).toInt() >= platedIndex)) {
+			result += QString("T%1\n").arg(tool).toUtf8();
+			Q_FOREACH (QPointF hole, holes) {
+				result += "X" + drillCoordinate(qRound(hole.x() * DrillUnits)) + "Y" + drillCoordinate(qRound(hole.y() * DrillUnits)) + "\n";
+			}
+			holes.clear();
+		}
+		if (!line.isEmpty()) result += line + "\n";
+	}
+	flushHits();
+
+	paths = result;
+}
@@ -0,0 +1,88 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef GERBERPANEL_H
+#define GERBERPANEL_H
+
+#include <QByteArray>
+#include <QLineF>
+#include <QList>
+#include <QPointF>
+#include <QRectF>
+#include <QSizeF>
+
+#include "svg2gerber.h"
+
+class GerberPanel
+{
+	// Step-and-repeat layout for ordering several copies of one board.
+	// Each layer of the single board is rendered once; apply() wraps the Gerber image in an %SR block,
+	// copies Excellon hits per board, and adds the panel rails, fiducials and mouse-bite tabs.
+	// The outline layer is drawn from the panel geometry instead, with real gaps in the cut where the tabs are.
+	// All sizes are in inches; the board occupies (0, 0) - (boardSize) in Gerber coordinates.
+
+public:
+	struct Tab {
+		QPointF center;			// middle of the gap the tab bridges
+		bool horizontal;		// the gap runs along x (between rows, or between a row and a rail)
+		bool edgeBefore;		// a board edge (not a rail) on the low side of the gap
+		bool edgeAfter;
+	};
+
+public:
+	GerberPanel() = default;
+	GerberPanel(int columns, int rows, double gap, double rail);
+
+	bool isEmpty() const;
+	int columns() const;
+	int rows() const;
+	void setBoardSize(const QSizeF &);
+	void setFiducials(bool);
+	void setMouseBites(bool);
+	QRectF panelRect() const;
+	QPointF boardOffset(int column, int row) const;
+	QList<QPointF> fiducials() const;
+	QList<Tab> tabs() const;
+	QList<QPointF> mouseBiteHoles() const;
+	QList<QLineF> cutLines() const;
+	void apply(QByteArray & header, QByteArray & paths, SVG2gerber::ForWhy) const;
+
+public:
+	static constexpr double FiducialDiameter = 0.03937;		// 1 mm copper dot
+	static constexpr double FiducialMaskDiameter = 0.07874;	// 2 mm mask opening
+	static constexpr double TabWidth = 0.2;
+	static constexpr double MouseBiteDiameter = 0.02;
+	static constexpr double MouseBitePitch = 0.03;
+
+protected:
+	void applyDrill(QByteArray & header, QByteArray & paths) const;
+	void applyImage(QByteArray & header, QByteArray & paths, SVG2gerber::ForWhy) const;
+
+protected:
+	int m_columns = 1;
+	int m_rows = 1;
+	QSizeF m_boardSize;
+	double m_gap = 0;
+	double m_rail = 0;
+	bool m_fiducials = false;
+	bool m_mouseBites = false;
+};
+
+#endif
@@ -25,6 +25,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QFileInfo>
 #include <QDateTime>
 #include <QTextDocument>
+#include <QIODevice>
 
 Kicad2Svg::Kicad2Svg() {
 }
@@ -64,3 +65,12 @@ QString Kicad2Svg::endMetadata() {
 	metadata += "</metadata>";
 	return metadata;
 }
+
+QString Kicad2Svg::readLine(QIODevice & device) {
+	// like QTextStream::readLine, but reads straight from the device so device.pos() stays a usable byte offset
+	QByteArray line = device.readLine();
+	while (line.endsWith('\n') || line.endsWith('\r')) {
+		line.chop(1);
+	}
+	return QString::fromUtf8(line);
+}
@@ -23,6 +23,8 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "x2svg.h"
 
+class QIODevice;
+
 class Kicad2Svg : public X2Svg
 {
 
@@ -32,6 +34,9 @@ public:
 	QString makeMetadata(const QString & filename, const QString & type, const QString & name);
 	QString endMetadata();
 
+public:
+	static QString readLine(QIODevice & device);
+
 protected:
 	QString m_title;
 	QString m_description;
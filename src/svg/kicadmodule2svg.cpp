@@ -53,41 +53,53 @@ double checkStrokeWidth(double w) {
 KicadModule2Svg::KicadModule2Svg() : Kicad2Svg() {
 }
 
-QStringList KicadModule2Svg::listModules(const QString & filename) {
+QStringList KicadModule2Svg::listModules(const QString & filename, QHash<QString, qint64> * offsets) {
 	QStringList modules;
 
 	QFile file(filename);
 	if (!file.open(QFile::ReadOnly)) return modules;
 
-	QTextStream textStream(&file);
+	// a single pass collects the $INDEX names and, if asked, the byte offset of each $MODULE
+	// so convert() can seek straight to it instead of rescanning the library per footprint
 	bool gotIndex = false;
-	while (true) {
-		QString line = textStream.readLine();
-		if (line.isNull()) break;
-
-		if (line.compare("$INDEX") == 0) {
-			gotIndex = true;
-			break;
+	bool gotEndIndex = false;
+	while (!file.atEnd()) {
+		qint64 pos = file.pos();
+		QString line = readLine(file);
+		if (!gotIndex) {
+			gotIndex = line.compare("$INDEX") == 0;
+			continue;
 		}
-	}
 
-	if (!gotIndex) return modules;
-	while (true) {
-		QString line = textStream.readLine();
-		if (line.isNull()) break;
+		if (!gotEndIndex) {
+			if (line.compare("$EndINDEX") == 0) {
+				gotEndIndex = true;
+				if (offsets == nullptr) break;
+
+				continue;
+			}
 
-		if (line.compare("$EndINDEX") == 0) {
-			return modules;
+			modules.append(line);
+			continue;
 		}
 
-		modules.append(line);
+		if (line.startsWith("$MODULE")) {
+			QString moduleName = line.mid(7).trimmed();
+			if (!offsets->contains(moduleName)) {
+				offsets->insert(moduleName, pos);
+			}
+		}
+	}
+
+	if (!gotEndIndex) {
+		modules.clear();
+		if (offsets != nullptr) offsets->clear();
 	}
 
-	modules.clear();
 	return modules;
 }
 
-QString KicadModule2Svg::convert(const QString & filename, const QString & moduleName, bool allowPadsAndPins)
+QString KicadModule2Svg::convert(const QString & filename, const QString & moduleName, bool allowPadsAndPins, qint64 offset)
 {
 	m_nonConnectorNumber = 0;
 	initLimits();
@@ -104,7 +116,16 @@ QString KicadModule2Svg::convert(const QString & filename, const QString & modul
 
 
 	bool gotModule = false;
-	while (true) {
+	if (offset >= 0 && textStream.seek(offset)) {
+		// offset comes from listModules(); fall back to scanning if the file changed underneath
+		QString line = textStream.readLine();
+		gotModule = line.startsWith("$MODULE") && line.mid(7).trimmed().compare(moduleName) == 0;
+		if (!gotModule) {
+			textStream.seek(0);
+		}
+	}
+
+	while (!gotModule) {
 		QString line = textStream.readLine();
 		if (line.isNull()) {
 			break;
@@ -112,7 +133,6 @@ QString KicadModule2Svg::convert(const QString & filename, const QString & modul
 
 		if (line.contains("$MODULE") && line.contains(moduleName, Qt::CaseInsensitive)) {
 			gotModule = true;
-			break;
 		}
 	}
 
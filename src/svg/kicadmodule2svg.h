@@ -24,6 +24,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QString>
 #include <QStringList>
 #include <QTextStream>
+#include <QHash>
 
 #include "kicad2svg.h"
 
@@ -32,10 +33,10 @@ class KicadModule2Svg : public Kicad2Svg
 
 public:
 	KicadModule2Svg();
-	QString convert(const QString & filename, const QString & moduleName, bool allowPadsAndPins);
+	QString convert(const QString & filename, const QString & moduleName, bool allowPadsAndPins, qint64 offset = -1);
 
 public:
-	static QStringList listModules(const QString & filename);
+	static QStringList listModules(const QString & filename, QHash<QString, qint64> * offsets = nullptr);
 
 public:
 	enum PadLayer {
@@ -38,21 +38,22 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 KicadSchematic2Svg::KicadSchematic2Svg() : Kicad2Svg() {
 }
 
-QStringList KicadSchematic2Svg::listDefs(const QString & filename) {
+QStringList KicadSchematic2Svg::listDefs(const QString & filename, QHash<QString, qint64> * offsets) {
 	QStringList defs;
 
 	QFile file(filename);
 	if (!file.open(QFile::ReadOnly)) return defs;
 
-	QTextStream textStream(&file);
-	while (true) {
-		QString line = textStream.readLine();
-		if (line.isNull()) break;
-
+	while (!file.atEnd()) {
+		qint64 pos = file.pos();
+		QString line = readLine(file);
 		if (line.startsWith("DEF")) {
 			QStringList linedefs = line.split(" ", Qt::SkipEmptyParts);
 			if (linedefs.count() > 1) {
 				defs.append(linedefs[1]);
+				if (offsets != nullptr && !offsets->contains(linedefs[1])) {
+					offsets->insert(linedefs[1], pos);
+				}
 			}
 		}
 	}
@@ -60,7 +61,7 @@ QStringList KicadSchematic2Svg::listDefs(const QString & filename) {
 	return defs;
 }
 
-QString KicadSchematic2Svg::convert(const QString & filename, const QString & defName)
+QString KicadSchematic2Svg::convert(const QString & filename, const QString & defName, qint64 offset)
 {
 	initLimits();
 
@@ -79,24 +80,38 @@ QString KicadSchematic2Svg::convert(const QString & filename, const QString & de
 	bool drawPinNumber = true;
 	bool drawPinName = true;
 	bool gotDef = false;
-	while (true) {
+	QString defLine;
+	if (offset >= 0 && textStream.seek(offset)) {
+		// offset comes from listDefs(); fall back to scanning if the file changed underneath
+		defLine = textStream.readLine();
+		QStringList linedefs = defLine.split(" ", Qt::SkipEmptyParts);
+		if (!defLine.startsWith("DEF") || linedefs.count() < 2 || linedefs[1].compare(defName) != 0) {
+			defLine.clear();
+			textStream.seek(0);
+		}
+	}
+
+	while (defLine.isEmpty()) {
 		QString line = textStream.readLine();
 		if (line.isNull()) {
 			break;
 		}
 
 		if (line.startsWith("DEF") && line.contains(defName, Qt::CaseInsensitive)) {
-			QStringList defs = splitLine(line);
-			if (defs.count() < 8) {
-				throw QObject::tr("bad schematic definition %1").arg(filename);
-			}
-			reference = defs[2];
-			textOffset = defs[4].toInt();
-			drawPinName = defs[6] == "Y";
-			drawPinNumber = defs[5] == "Y";
-			gotDef = true;
-			break;
+			defLine = line;
+		}
+	}
+
+	if (!defLine.isEmpty()) {
+		QStringList defs = splitLine(defLine);
+		if (defs.count() < 8) {
+			throw QObject::tr("bad schematic definition %1").arg(filename);
 		}
+		reference = defs[2];
+		textOffset = defs[4].toInt();
+		drawPinName = defs[6] == "Y";
+		drawPinNumber = defs[5] == "Y";
+		gotDef = true;
 	}
 
 	if (!gotDef) {
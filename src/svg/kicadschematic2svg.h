@@ -25,6 +25,7 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QStringList>
 #include <QTextStream>
 #include <QRectF>
+#include <QHash>
 
 #include "kicad2svg.h"
 
@@ -33,10 +34,10 @@ class KicadSchematic2Svg : public Kicad2Svg
 
 public:
 	KicadSchematic2Svg();
-	QString convert(const QString & filename, const QString &defName);
+	QString convert(const QString & filename, const QString &defName, qint64 offset = -1);
 
 public:
-	static QStringList listDefs(const QString & filename);
+	static QStringList listDefs(const QString & filename, QHash<QString, qint64> * offsets = nullptr);
 
 protected:
 	QString convertField(const QString & line);
@@ -21,7 +21,10 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "svg2gerber.h"
 #include "../debugdialog.h"
 #include "svgflattener.h"
+#include "drillorder.h"
+#include "gerberpanel.h"
 #include <QTextStream>
+#include <QIODevice>
 #include <QSettings>
 #include <QSet>
 #include <QtDebug>
@@ -31,6 +34,26 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 constexpr double MaskClearance = 0.0;  // 5 mils clearance
 constexpr double milsPerInch = 1000;  // used to convert mils (standard fritzing resolution) to inches
 
+// append the decimal digits of value without going through a temporary string
+static void appendInt(QByteArray & bytes, int value) {
+	char buffer[16];
+	char * end = buffer + sizeof(buffer);
+	char * p = end;
+	qint64 v = value;
+	bool negative = v < 0;
+	if (negative) v = -v;
+	do {
+		*--p = char('0' + (v % 10));
+		v /= 10;
+	} while (v != 0);
+	if (negative) *--p = '-';
+	bytes.append(p, end - p);
+}
+
+size_t qHash(const SVG2gerber::ApertureKey & key, size_t seed) {
+	return qHashMulti(seed, key.shape, key.a, key.b, key.c, key.d);
+}
+
 bool hasFill(QDomElement & element) {
 	QString fill = element.attribute("fill");
 	if (fill.isEmpty()) return true; // svg spec: default to black fill
@@ -73,7 +96,14 @@ int SVG2gerber::convert(const QString & svgStr, bool doubleSided, const QString
 }
 
 QString SVG2gerber::getGerber() {
-	return m_gerber_header + m_gerber_paths;
+	return QString::fromUtf8(m_gerber_header + m_gerber_paths);
+}
+
+bool SVG2gerber::write(QIODevice & device) {
+	// header and paths go out separately, so the output is never concatenated in memory
+	if (device.write(m_gerber_header) != m_gerber_header.size()) return false;
+
+	return device.write(m_gerber_paths) == m_gerber_paths.size();
 }
 
 int SVG2gerber::renderGerber(bool doubleSided, const QString & mainLayerName, ForWhy forWhy) {
@@ -82,8 +112,8 @@ int SVG2gerber::renderGerber(bool doubleSided, const QString & mainLayerName, Fo
 		// human readable description comments
 		m_gerber_header = "G04 MADE WITH FRITZING*\n";
 		m_gerber_header += "G04 WWW.FRITZING.ORG*\n";
-		m_gerber_header += QString("G04 %1 SIDED*\n").arg(doubleSided ? "DOUBLE" : "SINGLE");
-		m_gerber_header += QString("G04 HOLES%1PLATED*\n").arg(doubleSided ? " " : " NOT ");
+		m_gerber_header += doubleSided ? "G04 DOUBLE SIDED*\n" : "G04 SINGLE SIDED*\n";
+		m_gerber_header += doubleSided ? "G04 HOLES PLATED*\n" : "G04 HOLES NOT PLATED*\n";
 		m_gerber_header += "G04 CONTOUR ON CENTER OF CONTOUR VECTOR*\n";
 
 		if (gerberExportImprovementsEnabled) {
@@ -123,37 +153,23 @@ int SVG2gerber::renderGerber(bool doubleSided, const QString & mainLayerName, Fo
 	if (forWhy == ForDrill) {
 		static constexpr int initialHoleIndex = 1;
 		static constexpr int offset = 100;
-		int initialPlatedIndex = (((m_holeApertures.uniqueKeys().count() + initialHoleIndex - 1) / offset) + 1) * offset;
+		int initialPlatedIndex = (((m_holeHits.count() + initialHoleIndex - 1) / offset) + 1) * offset;
 		m_gerber_header = "";
-		m_gerber_header += QString("; NON-PLATED HOLES START AT T%1\n").arg(initialHoleIndex);
-		m_gerber_header += QString("; THROUGH (PLATED) HOLES START AT T%1\n").arg(initialPlatedIndex);
+		m_gerber_header += QString("; NON-PLATED HOLES START AT T%1\n").arg(initialHoleIndex).toUtf8();
+		m_gerber_header += QString("; THROUGH (PLATED) HOLES START AT T%1\n").arg(initialPlatedIndex).toUtf8();
 
 		// setup drill file header
 		m_gerber_header += "M48\n";
 		// set to english (inches) units, with trailing zeros
 		m_gerber_header += "INCH\n";
 
-		int ix = initialHoleIndex;
-		Q_FOREACH (QString aperture, m_holeApertures.uniqueKeys()) {
-			m_gerber_header += QString("T%1%2\n").arg(ix).arg(aperture);
-			m_gerber_paths += QString("T%1\n").arg(ix);
-			auto values = m_holeApertures.values(aperture);
-			Q_FOREACH (QString loc, QSet<QString>(values.begin(), values.end())) {
-				m_gerber_paths += loc + "\n";
-			}
-			ix++;
-		}
-
-		ix = initialPlatedIndex;
-		Q_FOREACH (QString aperture, m_platedApertures.uniqueKeys()) {
-			m_gerber_header += QString("T%1%2\n").arg(ix).arg(aperture);
-			m_gerber_paths += QString("T%1\n").arg(ix);
-			auto values = m_platedApertures.values(aperture);
-			Q_FOREACH (QString loc, QSet<QString>(values.begin(), values.end())) {
-				m_gerber_paths += loc + "\n";
-			}
-			ix++;
-		}
+		// the head carries over from one tool to the next, so each tool's tour starts near where the last one ended
+		bool optimize = QSettings().value("gerberOptimizeDrillOrder", true).toBool();
+		QPoint head(0, 0);
+		m_drillTravelBefore = m_drillTravelAfter = 0;
+		writeDrillHits(m_holeHits, initialHoleIndex, optimize, head);
+		writeDrillHits(m_platedHits, initialPlatedIndex, optimize, head);
+		DebugDialog::debug(QString("drill travel %1 in, %2 in after ordering").arg(m_drillTravelBefore / 10000).arg(m_drillTravelAfter / 10000));
 
 		m_gerber_header += "%\n";    // closes the header
 
@@ -168,7 +184,7 @@ int SVG2gerber::renderGerber(bool doubleSided, const QString & mainLayerName, Fo
 	else {
 		if (gerberExportImprovementsEnabled) {
 			// label our layers
-			m_gerber_header += QString("%G04%1*%\n").arg(mainLayerName.toUpper());
+			m_gerber_header += QString("%G04%1*%\n").arg(mainLayerName.toUpper()).toUtf8();
 
 			// Not sure why we configure this at the end of the job again.
 			// Assuming the old "just to be safe" comment was intended to leave a
@@ -179,7 +195,7 @@ int SVG2gerber::renderGerber(bool doubleSided, const QString & mainLayerName, Fo
 
 		} else {
 			// label our layers
-			m_gerber_header += QString("%LN%1*%\n").arg(mainLayerName.toUpper());
+			m_gerber_header += QString("%LN%1*%\n").arg(mainLayerName.toUpper()).toUtf8();
 
 			//just to be safe: G90 (absolute coords) and G70 (inches)
 			m_gerber_header += "G90*\nG70*\n";
@@ -187,7 +203,7 @@ int SVG2gerber::renderGerber(bool doubleSided, const QString & mainLayerName, Fo
 
 		// now write the footer
 		// comment to indicate end-of-sketch
-		m_gerber_paths += QString("G04 End of %1*\n").arg(mainLayerName);
+		m_gerber_paths += QString("G04 End of %1*\n").arg(mainLayerName).toUtf8();
 
 		// write gerber end-of-program
 		m_gerber_paths += "M02*";
@@ -196,6 +212,51 @@ int SVG2gerber::renderGerber(bool doubleSided, const QString & mainLayerName, Fo
 	return invalidCount;
 }
 
+void SVG2gerber::writeDrillHits(const QMap<QString, QList<QPoint>> & hits, int initialIndex, bool optimize, QPoint & head) {
+	int ix = initialIndex;
+	for (auto it = hits.constBegin(); it != hits.constEnd(); ++it) {
+		m_gerber_header += QString("T%1%2\n").arg(ix).arg(it.key()).toUtf8();
+		m_gerber_paths += QString("T%1\n").arg(ix).toUtf8();
+
+		// parts can stack the same hole more than once
+		QList<QPoint> unique;
+		QSet<QPoint> already;
+		Q_FOREACH (QPoint hit, it.value()) {
+			if (already.contains(hit)) continue;
+
+			already.insert(hit);
+			unique.append(hit);
+		}
+
+		m_drillTravelBefore += DrillOrder::travel(unique, head);
+		if (optimize) {
+			unique = DrillOrder::optimize(unique, head);
+		}
+		m_drillTravelAfter += DrillOrder::travel(unique, head);
+		if (!unique.isEmpty()) {
+			head = unique.last();
+		}
+
+		Q_FOREACH (QPoint hit, unique) {
+			m_gerber_paths += QString("X%1Y%2\n").arg(hit.x(), 6, 10, QChar('0')).arg(hit.y(), 6, 10, QChar('0')).toUtf8();
+		}
+		ix++;
+	}
+}
+
+void SVG2gerber::panelize(const GerberPanel & panel, ForWhy forWhy) {
+	panel.apply(m_gerber_header, m_gerber_paths, forWhy);
+}
+
+double SVG2gerber::drillTravelBefore() {
+	// in 10000ths of an inch, the unit of the drill file
+	return m_drillTravelBefore;
+}
+
+double SVG2gerber::drillTravelAfter() {
+	return m_drillTravelAfter;
+}
+
 void SVG2gerber::normalizeSVG() {
 	QDomElement root = m_SVGDom.documentElement();
 
@@ -288,17 +349,34 @@ QTransform SVG2gerber::parseTransform(QDomElement element) {
 	return transform;
 }
 
+void SVG2gerber::collectShapes(const QDomElement & element, Shapes & shapes) {
+	QString tagName = element.tagName();
+	if (tagName == "circle") shapes.circles.append(element);
+	else if (tagName == "rect") shapes.rects.append(element);
+	else if (tagName == "polygon") shapes.polygons.append(element);
+	else if (tagName == "polyline") shapes.polylines.append(element);
+	else if (tagName == "line") shapes.lines.append(element);
+	else if (tagName == "path") shapes.paths.append(element);
+
+	QDomElement child = element.firstChildElement();
+	while (!child.isNull()) {
+		collectShapes(child, shapes);
+		child = child.nextSiblingElement();
+	}
+}
+
 int SVG2gerber::allPaths2gerber(ForWhy forWhy) {
 	int invalidPathsCount = 0;
-	QHash<QString, QString> apertureMap;
-	QString current_dcode;
-	int dcode_index = 10;
+	m_apertures.clear();
+	m_apertureDefinitions.clear();
+	m_dcodeIndex = 10;
+	m_currentDcode = -1;
 	bool light_on = false;
 	int currentx = -1;
 	int currenty = -1;
 
-	m_holeApertures.clear();
-	m_platedApertures.clear();
+	m_holeHits.clear();
+	m_platedHits.clear();
 
 	// iterates through all circles, rects, lines and paths
 	//  1. check if we already have an aperture
@@ -306,23 +384,10 @@ int SVG2gerber::allPaths2gerber(ForWhy forWhy) {
 	//  2. switch to this aperture
 	//  3. draw it at the correct path/location
 
-	QDomNodeList circleList = m_SVGDom.elementsByTagName("circle");
-	//DebugDialog::debug("circles to gerber: " + QString::number(circleList.length()));
-
-	QDomNodeList rectList = m_SVGDom.elementsByTagName("rect");
-	//DebugDialog::debug("rects to gerber: " + QString::number(rectList.length()));
-
-	QDomNodeList polyList = m_SVGDom.elementsByTagName("polygon");
-	//DebugDialog::debug("polygons to gerber: " + QString::number(polyList.length()));
-
-	QDomNodeList polyLineList = m_SVGDom.elementsByTagName("polyline");
-	//DebugDialog::debug("polylines to gerber: " + QString::number(polyLineList.length()));
-
-	QDomNodeList lineList = m_SVGDom.elementsByTagName("line");
-	//DebugDialog::debug("lines to gerber: " + QString::number(lineList.length()));
-
-	QDomNodeList pathList = m_SVGDom.elementsByTagName("path");
-	//DebugDialog::debug("paths to gerber: " + QString::number(pathList.length()));
+	// one walk over the flattened document instead of a full elementsByTagName search per shape type;
+	// each list keeps document order, so the output is unchanged
+	Shapes shapes;
+	collectShapes(m_SVGDom.documentElement(), shapes);
 
 	// if this is the board outline, use it as the contour
 	if (forWhy == ForOutline) {
@@ -333,8 +398,7 @@ int SVG2gerber::allPaths2gerber(ForWhy forWhy) {
 	}
 
 	// circles
-	for(int i = 0; i < circleList.length(); i++) {
-		QDomElement circle = circleList.item(i).toElement();
+	Q_FOREACH (QDomElement circle, shapes.circles) {
 
 		double centerx = circle.attribute("cx").toDouble();
 		double centery = circle.attribute("cy").toDouble();
@@ -351,20 +415,13 @@ int SVG2gerber::allPaths2gerber(ForWhy forWhy) {
 		if (forWhy == ForDrill) {
 			if (noDrill) continue;
 
-			QString drill_cx = QString("%1").arg((int) (centerx * 10), 6, 10, QChar('0'));				// drill file is in inches 00.0000, converting mils to 10000ths
-			QString drill_cy = QString("%1").arg((int) (flipy(centery) * 10), 6, 10, QChar('0'));				// drill file is in inches 00.0000, converting mils to 10000ths
+			QPoint hit((int) (centerx * 10), (int) (flipy(centery) * 10));		// drill file is in inches 00.0000, converting mils to 10000ths
 			QString aperture = QString("C%1").arg(hole, 0, 'f');
-			QString loc = "X" + drill_cx + "Y" + drill_cy;
-			if (stroke_width == 0) m_holeApertures.insert(aperture, loc);
-			else m_platedApertures.insert(aperture, loc);
+			if (stroke_width == 0) m_holeHits[aperture].append(hit);
+			else m_platedHits[aperture].append(hit);
 			continue;
 		}
 
-		QString aperture;
-
-		QString cx = f2gerber(centerx);
-		QString cy = f2gerber(flipy(centery));
-
 		QString fill = circle.attribute("fill");
 
 		double diam = ((2*r) + stroke_width)/milsPerInch;
@@ -372,54 +429,36 @@ int SVG2gerber::allPaths2gerber(ForWhy forWhy) {
 			diam += 2 * MaskClearance;
 		}
 
+		ApertureKey key { 'C', diam, 0, 0, 0 };
 		if ((forWhy != ForCopper && fill=="none" && forWhy != ForMask) || (forWhy == ForCopper && noDrill)) {
-			aperture = QString("C,%1X%2").arg(diam, 0, 'f').arg(hole);
-		}
-		else {
-			aperture = QString("C,%1").arg(diam, 0, 'f');
+			key = { 'H', diam, hole, 0, 0 };
 		}
 
-
 		// add aperture to defs if we don't have it yet
-		if(!apertureMap.contains(aperture)) {
-			apertureMap[aperture] = QString::number(dcode_index);
-			m_gerber_header += "%ADD" + QString::number(dcode_index) + aperture + "*%\n";
-			dcode_index++;
-		}
+		int dcode = aperture(key);
 
 		if (forWhy != ForOutline) {
-			QString dcode = apertureMap[aperture];
-			if(current_dcode != dcode) {
-				//switch to correct aperture
-				m_gerber_paths += m_G54 + "D" + dcode + "*\n";
-				current_dcode = dcode;
-			}
+			selectAperture(dcode);
 			//flash
-			m_gerber_paths += "X" + cx + "Y" + cy + "D03*\n";
+			appendXY(centerx, flipy(centery), "D03*\n");
 		}
 		else {
-			standardAperture(circle, apertureMap, current_dcode, dcode_index, 0);
+			standardAperture(circle, 0);
 
 			// create circle outline
-			m_gerber_paths += QString(
-					"G01X%1Y%2D02*\n"
-					"G75*\n"
-					"G03X%1Y%2I%3J0D01*\n"
-				)
-				.arg(f2gerber(centerx + r)
-					,f2gerber(flipy(centery))
-					,f2gerber(-r)
-				);
+			m_gerber_paths += "G01";
+			appendXY(centerx + r, flipy(centery), "D02*\n");
+			m_gerber_paths += "G75*\nG03";
+			appendXY(centerx + r, flipy(centery), "I");
+			appendInt(m_gerber_paths, qRound(-r * m_f2g));
+			m_gerber_paths += "J0D01*\n";
 			m_gerber_paths += "G01*\n";
 		}
 	}
 
 	if (forWhy != ForDrill) {
 		// rects
-		for(int j = 0; j < rectList.length(); j++) {
-			QDomElement rect = rectList.item(j).toElement();
-
-			QString aperture;
+		Q_FOREACH (QDomElement rect, shapes.rects) {
 
 			double width = rect.attribute("width").toDouble();
 			double height = rect.attribute("height").toDouble();
@@ -439,8 +478,6 @@ int SVG2gerber::allPaths2gerber(ForWhy forWhy) {
 			double y = rect.attribute("y").toDouble();
 			double centerx = x + (width/2.0);
 			double centery = y + (height/2.0);
-			QString cx = f2gerber(centerx);
-			QString cy = f2gerber(flipy(centery));
 
 			QString fill = rect.attribute("fill");
 			double stroke_width = rect.attribute("stroke-width").toDouble();
@@ -456,50 +493,38 @@ int SVG2gerber::allPaths2gerber(ForWhy forWhy) {
 			}
 
 
+			ApertureKey key { 'R', totalx, totaly, 0, 0 };
 			if(forWhy != ForCopper && fill=="none" && forWhy != ForMask) {
-				aperture = QString("R,%1X%2X%3X%4").arg(totalx, 0, 'f').arg(totaly, 0, 'f').arg(holex, 0, 'f').arg(holey, 0, 'f');
-			}
-			else {
-				aperture = QString("R,%1X%2").arg(totalx, 0, 'f').arg(totaly, 0, 'f');
+				key = { 'O', totalx, totaly, holex, holey };
 			}
 
 			// add aperture to defs if we don't have it yet
-			if(!apertureMap.contains(aperture)) {
-				apertureMap[aperture] = QString::number(dcode_index);
-				m_gerber_header += "%ADD" + QString::number(dcode_index) + aperture + "*%\n";
-				dcode_index++;
-			}
+			int dcode = aperture(key);
 
 			bool doLines = false;
 			if (forWhy == ForOutline) doLines = true;
 			else if (forWhy == ForSilk && fill == "none") doLines = true;
 
 			if (!doLines) {
-				QString dcode = apertureMap[aperture];
-				if(current_dcode != dcode) {
-					//switch to correct aperture
-					m_gerber_paths += m_G54 + "D" + dcode + "*\n";
-					current_dcode = dcode;
-				}
+				selectAperture(dcode);
 				//flash
-				m_gerber_paths += "X" + cx + "Y" + cy + "D03*\n";
+				appendXY(centerx, flipy(centery), "D03*\n");
 			}
 			else {
 				// draw 4 lines
 
-				standardAperture(rect, apertureMap, current_dcode, dcode_index, 0);
-				m_gerber_paths += "X" + f2gerber(x) + "Y" + f2gerber(flipy(y)) + "D02*\n";
-				m_gerber_paths += "X" + f2gerber(x+width) + "Y" + f2gerber(flipy(y)) + "D01*\n";
-				m_gerber_paths += "X" + f2gerber(x+width) + "Y" + f2gerber(flipy(y+height)) + "D01*\n";
-				m_gerber_paths += "X" + f2gerber(x) + "Y" + f2gerber(flipy(y+height)) + "D01*\n";
-				m_gerber_paths += "X" + f2gerber(x) + "Y" + f2gerber(flipy(y)) + "D01*\n";
+				standardAperture(rect, 0);
+				appendXY(x, flipy(y), "D02*\n");
+				appendXY(x+width, flipy(y), "D01*\n");
+				appendXY(x+width, flipy(y+height), "D01*\n");
+				appendXY(x, flipy(y+height), "D01*\n");
+				appendXY(x, flipy(y), "D01*\n");
 				m_gerber_paths += "D02*\n";
 			}
 		}
 
 		// lines - NOTE: this assumes a circular aperture
-		for(int k = 0; k < lineList.length(); k++) {
-			QDomElement line = lineList.item(k).toElement();
+		Q_FOREACH (QDomElement line, shapes.lines) {
 
 			// Note: should be no forWhy == ForMask cases
 
@@ -508,7 +533,7 @@ int SVG2gerber::allPaths2gerber(ForWhy forWhy) {
 			double x2 = line.attribute("x2").toDouble();
 			double y2 = line.attribute("y2").toDouble();
 
-			standardAperture(line, apertureMap, current_dcode, dcode_index, 0);
+			standardAperture(line, 0);
 
 			// turn off light if we are not continuing along a path
 			if ((y1 != currenty) || (x1 != currentx)) {
@@ -519,31 +544,28 @@ int SVG2gerber::allPaths2gerber(ForWhy forWhy) {
 			}
 
 			//go to start - light off
-			m_gerber_paths += "X" + f2gerber(x1) + "Y" + f2gerber(flipy(y1)) + "D02*\n";
+			appendXY(x1, flipy(y1), "D02*\n");
 			//go to end point - light on
-			m_gerber_paths += "X" + f2gerber(x2) + "Y" + f2gerber(flipy(y2)) + "D01*\n";
+			appendXY(x2, flipy(y2), "D01*\n");
 			light_on = true;
 			currentx = x2;
 			currenty = y2;
 		}
 
 		// polys - NOTE: assumes comma- or space- separated formatting
-		for(int p = 0; p < polyList.length(); p++) {
-			QDomElement polygon = polyList.item(p).toElement();
-			doPoly(polygon, forWhy, true, apertureMap, current_dcode, dcode_index);
+		Q_FOREACH (QDomElement polygon, shapes.polygons) {
+			doPoly(polygon, forWhy, true);
 		}
-		for(int p = 0; p < polyLineList.length(); p++) {
-			QDomElement polygon = polyLineList.item(p).toElement();
-			doPoly(polygon, forWhy, false, apertureMap, current_dcode, dcode_index);
+		Q_FOREACH (QDomElement polygon, shapes.polylines) {
+			doPoly(polygon, forWhy, false);
 		}
 	}
 
 	// paths - NOTE: this assumes circular aperture
-	for(int n = 0; n < pathList.length(); n++) {
-		QDomElement path = pathList.item(n).toElement();
+	Q_FOREACH (QDomElement path, shapes.paths) {
 
 		if (forWhy == ForDrill) {
-			handleOblongPath(path, dcode_index);  // this is currently a no-op
+			handleOblongPath(path);  // this is currently a no-op
 			continue;
 		}
 
@@ -586,10 +608,10 @@ int SVG2gerber::allPaths2gerber(ForWhy forWhy) {
 		if (hasFill(path) && (forWhy != ForOutline)) {
 			// use a minimal aperture. gerbv seems to use the last used aperture for image size calculation
 			// the aperture should not matter for the fill, though
-			standardAperture(path, apertureMap, current_dcode, dcode_index,  0.1);
+			standardAperture(path, 0.1);
 			// start poly fill
 			m_gerber_paths += "G36*\n";
-			m_gerber_paths += pathUserData.string;
+			m_gerber_paths += pathUserData.string.toUtf8();
 			//DebugDialog::debug("path id: " + path.attribute("id"));
 			// stop poly fill
 			m_gerber_paths += "G37*\n";
@@ -605,28 +627,16 @@ int SVG2gerber::allPaths2gerber(ForWhy forWhy) {
 			if (path.attribute("stroke-linecap") == "square") {
 
 				if (stroke_width != 0) {
-					QString aperture = QString("R,%1X%1").arg(stroke_width/milsPerInch, 0, 'f');
-
 					// add aperture to defs if we don't have it yet
-					if (!apertureMap.contains(aperture)) {
-						apertureMap[aperture] = QString::number(dcode_index);
-						m_gerber_header += "%ADD" + QString::number(dcode_index) + aperture + "*%\n";
-						dcode_index++;
-					}
-
-					QString dcode = apertureMap[aperture];
-					if (current_dcode != dcode) {
-						//switch to correct aperture
-					m_gerber_paths += m_G54 + "D" + dcode + "*\n";
-						current_dcode = dcode;
-					}
+					ApertureKey key { 'R', stroke_width/milsPerInch, stroke_width/milsPerInch, 0, 0 };
+					selectAperture(aperture(key));
 				}
 			}
 			else {
-				standardAperture(path, apertureMap, current_dcode, dcode_index,  stroke_width);
+				standardAperture(path, stroke_width);
 			}
 
-			m_gerber_paths += pathUserData.string;
+			m_gerber_paths += pathUserData.string.toUtf8();
 		}
 
 		// light off
@@ -642,44 +652,48 @@ int SVG2gerber::allPaths2gerber(ForWhy forWhy) {
 	return invalidPathsCount;
 }
 
-void SVG2gerber::doPoly(QDomElement & polygon, ForWhy forWhy, bool closedCurve,
-						QHash<QString, QString> & apertureMap, QString & current_dcode, int & dcode_index)
+void SVG2gerber::doPoly(QDomElement & polygon, ForWhy forWhy, bool closedCurve)
 {
 	QString points = polygon.attribute("points");
-	QStringList pointList = points.split(QRegularExpression("\\s+|,"), Qt::SkipEmptyParts);
+	static const QRegularExpression separators("\\s+|,");
+	QStringList pointList = points.split(separators, Qt::SkipEmptyParts);
 
 	if (pointList.length() < 4) {
 		DebugDialog::debug(QString("Empty polyline %1").arg(points), DebugDialog::Error);
 		return;
 	}
 
-	QString aperture;
-
-	QString pointString;
+	// the points are written once at the end of m_gerber_paths, then copied if both fill and outline need them
+	QByteArray savedPaths;
+	savedPaths.swap(m_gerber_paths);
 
 	double startx = pointList.at(0).toDouble();
 	double starty = pointList.at(1).toDouble();
 	// move to start - light off
-	pointString += "X" + f2gerber(startx) + "Y" + f2gerber(flipy(starty)) + "D02*\n";
+	appendXY(startx, flipy(starty), "D02*\n");
 
 	// iterate through all other points - light on
 	for(int pt = 2; pt < pointList.length(); pt +=2) {
 		double ptx = pointList.at(pt).toDouble();
 		double pty = pointList.at(pt+1).toDouble();
-		pointString += "X" + f2gerber(ptx) + "Y" + f2gerber(flipy(pty)) + "D01*\n";
+		appendXY(ptx, flipy(pty), "D01*\n");
 	}
 
 	if (closedCurve) {
 		// move back to start point
-		pointString += "X" + f2gerber(startx) + "Y" + f2gerber(flipy(starty)) + "D01*\n";
+		appendXY(startx, flipy(starty), "D01*\n");
 	}
 
+	QByteArray pointString;
+	pointString.swap(m_gerber_paths);
+	m_gerber_paths.swap(savedPaths);
+
 	double stroke_width = polygon.attribute("stroke-width").toDouble();
 
 	// add poly fill if this is actually a filled in shape
 	if (hasFill(polygon) && (forWhy != ForOutline)) {
 		// use a minimal aperture. gerbv seems to use the last used aperture for image size calculation
-		standardAperture(polygon, apertureMap, current_dcode, dcode_index,  0.1);
+		standardAperture(polygon, 0.1);
 		// start poly fill
 		m_gerber_paths += "G36*\n";
 		m_gerber_paths += pointString;
@@ -696,7 +710,7 @@ void SVG2gerber::doPoly(QDomElement & polygon, ForWhy forWhy, bool closedCurve,
 			 stroke_width += (MaskClearance * 2 * milsPerInch);
 		}
 		// draw the outline, G36 only does the fill
-		standardAperture(polygon, apertureMap, current_dcode, dcode_index,  stroke_width);
+		standardAperture(polygon, stroke_width);
 		m_gerber_paths += pointString;
 	}
 
@@ -704,33 +718,65 @@ void SVG2gerber::doPoly(QDomElement & polygon, ForWhy forWhy, bool closedCurve,
 	m_gerber_paths += "D02*\n";
 }
 
-QString SVG2gerber::standardAperture(QDomElement & element, QHash<QString, QString> & apertureMap, QString & current_dcode, int & dcode_index, double stroke_width) {
+void SVG2gerber::standardAperture(QDomElement & element, double stroke_width) {
 	if (stroke_width == 0) {
 		stroke_width = element.attribute("stroke-width").toDouble();
 	}
-	if (stroke_width == 0) return "";
-
-	QString aperture = QString("C,%1").arg(stroke_width/milsPerInch, 0, 'f');
+	if (stroke_width == 0) return;
 
 	// add aperture to defs if we don't have it yet
-	if (!apertureMap.contains(aperture)) {
-		apertureMap[aperture] = QString::number(dcode_index);
-		m_gerber_header += "%ADD" + QString::number(dcode_index) + aperture + "*%\n";
-		dcode_index++;
+	ApertureKey key { 'C', stroke_width/milsPerInch, 0, 0, 0 };
+	selectAperture(aperture(key));
+}
+
+int SVG2gerber::aperture(const ApertureKey & key) {
+	// primitives mostly repeat exact parameters, so the numeric key avoids formatting a definition per primitive
+	auto it = m_apertures.constFind(key);
+	if (it != m_apertures.constEnd()) return it.value();
+
+	QString definition;
+	switch (key.shape) {
+	case 'H':
+		definition = QString("C,%1X%2").arg(key.a, 0, 'f').arg(key.b);
+		break;
+	case 'R':
+		definition = QString("R,%1X%2").arg(key.a, 0, 'f').arg(key.b, 0, 'f');
+		break;
+	case 'O':
+		definition = QString("R,%1X%2X%3X%4").arg(key.a, 0, 'f').arg(key.b, 0, 'f').arg(key.c, 0, 'f').arg(key.d, 0, 'f');
+		break;
+	default:
+		definition = QString("C,%1").arg(key.a, 0, 'f');
+		break;
 	}
 
-	QString dcode = apertureMap[aperture];
-	if (current_dcode != dcode) {
-		//switch to correct aperture
-		m_gerber_paths += m_G54 + "D" + dcode + "*\n";
-		current_dcode = dcode;
+	QByteArray bytes = definition.toUtf8();
+	int dcode = m_apertureDefinitions.value(bytes, -1);
+	if (dcode < 0) {
+		dcode = m_dcodeIndex++;
+		m_apertureDefinitions.insert(bytes, dcode);
+		m_gerber_header += "%ADD";
+		appendInt(m_gerber_header, dcode);
+		m_gerber_header += bytes;
+		m_gerber_header += "*%\n";
 	}
 
-	return aperture;
+	m_apertures.insert(key, dcode);
+	return dcode;
+}
+
+void SVG2gerber::selectAperture(int dcode) {
+	if (m_currentDcode == dcode) return;
 
+	//switch to correct aperture
+	m_gerber_paths += m_G54;
+	m_gerber_paths += 'D';
+	appendInt(m_gerber_paths, dcode);
+	m_gerber_paths += "*\n";
+	m_currentDcode = dcode;
 }
 
-void SVG2gerber::handleOblongPath(QDomElement & path, int & dcode_index) {
+void SVG2gerber::handleOblongPath(QDomElement & path) {
 	// this code has not been tested in a long time and is probably obsolete
 	return;
 
@@ -751,14 +797,14 @@ void SVG2gerber::handleOblongPath(QDomElement & path, int & dcode_index) {
 	double cx2 = nextLine.attribute("x2").toDouble();
 	double cy2 = nextLine.attribute("y2").toDouble();
 
-	QString drill_aperture = QString("C%1").arg(diameter / milsPerInch, 0, 'f') + "\n";   // convert mils to inches
+	QByteArray drill_aperture = QString("C%1").arg(diameter / milsPerInch, 0, 'f').toUtf8() + "\n";   // convert mils to inches
 	if (!m_gerber_header.contains(drill_aperture)) {
-		m_gerber_header += "T" + QString::number(dcode_index++) + drill_aperture;
+		m_gerber_header += "T" + QByteArray::number(m_dcodeIndex++) + drill_aperture;
 	}
 	int ix = m_gerber_header.indexOf(drill_aperture);
 	int it = m_gerber_header.lastIndexOf("T", ix);
 	m_drill_slots += QString("%1\nX%2Y%3G85X%4Y%5\nG05\n")
-					 .arg(m_gerber_header.mid(it, ix - it), 0, 'f')
+					 .arg(QString::fromUtf8(m_gerber_header.mid(it, ix - it)), 0, 'f')
 					 .arg((int) (cx1 * 10), 6, 10, QChar('0'))
 					 .arg((int) (flipy(cy1) * 10), 6, 10, QChar('0'))
 					 .arg((int) (cx2 * 10), 6, 10, QChar('0'))
@@ -868,6 +914,16 @@ QString SVG2gerber::f2gerber(double value)
 	return QString::number(qRound(value * m_f2g));
 }
 
+void SVG2gerber::appendXY(double x, double y, const char * operation)
+{
+	// same digits as f2gerber, written straight into the path buffer
+	m_gerber_paths += 'X';
+	appendInt(m_gerber_paths, qRound(x * m_f2g));
+	m_gerber_paths += 'Y';
+	appendInt(m_gerber_paths, qRound(y * m_f2g));
+	m_gerber_paths += operation;
+}
+
 double SVG2gerber::flipy(double y)
 {
 	return m_boardSize.height() - y;
@@ -26,6 +26,13 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QObject>
 #include <QTransform>
 #include <QMultiHash>
+#include <QByteArray>
+#include <QHash>
+#include <QMap>
+#include <QPoint>
+
+class QIODevice;
+class GerberPanel;
 
 class SVG2gerber : public QObject
 {
@@ -46,15 +53,38 @@ public:
 
 	int convert(const QString & svgStr, bool doubleSided, const QString & mainLayerName, ForWhy, QSizeF boardSize);
 	QString getGerber();
+	bool write(QIODevice &);
+	void panelize(const GerberPanel &, ForWhy);
+	double drillTravelBefore();
+	double drillTravelAfter();
+
+public:
+	struct ApertureKey {
+		char shape;		// 'C' circle, 'H' circle with hole, 'R' rectangle, 'O' rectangle with hole
+		double a;
+		double b;
+		double c;
+		double d;
+
+		bool operator==(const ApertureKey & other) const {
+			return shape == other.shape && a == other.a && b == other.b && c == other.c && d == other.d;
+		}
+	};
 
 protected:
 	QDomDocument m_SVGDom;
-	QString m_gerber_header;
-	QString m_gerber_paths;
+	QByteArray m_gerber_header;
+	QByteArray m_gerber_paths;
 	QString m_drill_slots;
+	QHash<ApertureKey, int> m_apertures;			// exact parameters -> dcode
+	QHash<QByteArray, int> m_apertureDefinitions;	// so parameters that print alike share a dcode
+	int m_dcodeIndex = 10;
+	int m_currentDcode = -1;
 	QSizeF m_boardSize;
-	QMultiHash<QString, QString> m_platedApertures;
-	QMultiHash<QString, QString> m_holeApertures;
+	QMap<QString, QList<QPoint>> m_platedHits;		// drill aperture -> hits in document order
+	QMap<QString, QList<QPoint>> m_holeHits;
+	double m_drillTravelBefore = 0.0;
+	double m_drillTravelAfter = 0.0;
 
 	double m_pathstart_x = 0.0;
 	double m_pathstart_y = 0.0;
@@ -63,7 +93,7 @@ protected:
 	// legacy gerber export is 1000mil (3 decimals). For 6 decimal
 	// gerber export, this will be set to 1000.0
 	double m_f2g = 1.0;
-	QString m_G54 = "G54";
+	QByteArray m_G54 = "G54";
 
 protected:
 
@@ -76,18 +106,31 @@ protected:
 
 	void copyStyles(QDomElement, QDomElement);
 
+	struct Shapes {
+		QList<QDomElement> circles;
+		QList<QDomElement> rects;
+		QList<QDomElement> polygons;
+		QList<QDomElement> polylines;
+		QList<QDomElement> lines;
+		QList<QDomElement> paths;
+	};
+
 	int renderGerber(bool doubleSided, const QString & mainLayerName, ForWhy);
+	void collectShapes(const QDomElement &, Shapes &);
 	int allPaths2gerber(ForWhy);
 	QString path2gerber(QDomElement);
-	void handleOblongPath(QDomElement & path, int & dcode_index);
-	QString standardAperture(QDomElement & element, QHash<QString, QString> & apertureMap, QString & current_dcode, int & dcode_index, double stroke_width);
+	void handleOblongPath(QDomElement & path);
+	void standardAperture(QDomElement & element, double stroke_width);
+	int aperture(const ApertureKey &);
+	void selectAperture(int dcode);
 	double flipy(double y);
 
 	// Transform from Fritzing scale to Gerber scale
 	QString f2gerber(double value);
+	void appendXY(double x, double y, const char * operation);
 
-	void doPoly(QDomElement & polygon, ForWhy forWhy, bool closedCurve,
-	            QHash<QString, QString> & apertureMap, QString & current_dcode, int & dcode_index);
+	void doPoly(QDomElement & polygon, ForWhy forWhy, bool closedCurve);
+	void writeDrillHits(const QMap<QString, QList<QPoint>> & hits, int initialIndex, bool optimize, QPoint & head);
 
 
 
@@ -97,4 +140,6 @@ protected Q_SLOTS:
 
 };
 
+size_t qHash(const SVG2gerber::ApertureKey &, size_t seed = 0);
+
 #endif // SVG2GERBER_H
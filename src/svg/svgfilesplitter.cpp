@@ -23,9 +23,9 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include "../utils/misc.h"
 #include "../utils/textutils.h"
 #include "../debugdialog.h"
-#include "svgpathparser.h"
 #include "svgpathlexer.h"
 #include "svgpathrunner.h"
+#include "svgpathscanner.h"
 
 #include <QDomDocument>
 #include <QFile>
@@ -879,35 +879,27 @@ void SvgFileSplitter::standardArgs(bool relative, bool starting, QList<double> &
 	}
 }
 
-QVector<QVariant> SvgFileSplitter::simpleParsePath(const QString & data) {
-	static QVector<QVariant> emptyStack;
+SVGPathData SvgFileSplitter::simpleParsePath(const QString & data) {
+	SVGPathData pathData;
+	if (data.isEmpty()) return pathData;
 
-	QString dataCopy(data);
-
-	if (!dataCopy.startsWith('M', Qt::CaseInsensitive)) {
-		dataCopy.prepend('M');
-	}
-	while (dataCopy.at(dataCopy.length() - 1).isSpace()) {
-		dataCopy.remove(dataCopy.length() - 1, 1);
-	}
-	QChar last = dataCopy.at(dataCopy.length() - 1);
-	if (last != 'z' && last != 'Z' && last != SVGPathLexer::FakeClosePathChar) {
-		dataCopy.append(SVGPathLexer::FakeClosePathChar);
+	// a missing leading moveto is assumed to be an absolute one; FakeClosePathChar needs no special handling
+	int start = 0;
+	while (start < data.length() && data.at(start).isSpace()) start++;
+	if (start < data.length() && data.at(start).toUpper() == 'M') {
+		SVGPathScanner::scan(data, pathData);
 	}
-
-	SVGPathLexer lexer(dataCopy);
-	SVGPathParser parser;
-	if (!parser.parse(lexer)) {
-		//DebugDialog::debug(QString("svg path parse failed %1").arg(dataCopy));
-		return emptyStack;
+	else {
+		SVGPathScanner::scan(QString('M') + data, pathData);
 	}
 
-	return parser.symStack();
+	//if (pathData.isEmpty()) DebugDialog::debug(QString("svg path parse failed %1").arg(data));
+	return pathData;
 }
 
 
 bool SvgFileSplitter::parsePath(const QString & dataString, const char * slot, PathUserData & pathUserData, QObject * slotTarget, bool convertHV) {
-	QVector<QVariant> symStack = simpleParsePath(dataString);
+	SVGPathData pathData = simpleParsePath(dataString);
 
 	if (convertHV && (dataString.contains("h", Qt::CaseInsensitive) || dataString.contains("v",  Qt::CaseInsensitive)))
 	{
@@ -918,13 +910,13 @@ bool SvgFileSplitter::parsePath(const QString & dataString, const char * slot, P
 		connect(&svgPathRunner, SIGNAL(commandSignal(QChar, bool, QList<double> &, void *)),
 		        this, SLOT(convertHVSlot(QChar, bool, QList<double> &, void *)),
 		        Qt::DirectConnection);
-		svgPathRunner.runPath(symStack, &data);
+		svgPathRunner.runPath(pathData, &data);
 		return parsePath(data.path, slot, pathUserData, slotTarget, false);
 	}
 
 	SVGPathRunner svgPathRunner;
 	connect(&svgPathRunner, SIGNAL(commandSignal(QChar, bool, QList<double> &, void *)), slotTarget, slot, Qt::DirectConnection);
-	return svgPathRunner.runPath(symStack, &pathUserData);
+	return svgPathRunner.runPath(pathData, &pathUserData);
 }
 
 void SvgFileSplitter::convertHVSlot(QChar command, bool /* relative */, QList<double> & args, void * userData) {
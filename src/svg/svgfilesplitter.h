@@ -30,6 +30,8 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QPainterPath>
 #include <QFile>
 
+#include "svgpathscanner.h"
+
 struct PathUserData {
 	QString string;
 	QTransform transform;
@@ -56,7 +58,7 @@ public:
 	QString shift(double x, double y, const QString & elementID, bool shiftTransforms);
 	QString elementString(const QString & elementID);
 	virtual bool parsePath(const QString & data, const char * slot, PathUserData &, QObject * slotTarget, bool convertHV);
-	QVector<QVariant> simpleParsePath(const QString & data);
+	SVGPathData simpleParsePath(const QString & data);
 	QPainterPath painterPath(double dpi, const QString & elementID);			// note: only partially implemented
 	void shiftChild(QDomElement & element, double x, double y, bool shiftTransforms);
 	bool load(const QString * filename);
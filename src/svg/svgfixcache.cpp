@@ -0,0 +1,162 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "svgfixcache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+
+static const QByteArray FixVersion("1");
+static const QString CacheSuffix(".svg");
+static constexpr qint64 TouchIntervalSecs = 24 * 60 * 60;		// eviction only needs last use to the day
+
+QString SvgFixCache::Folder;
+qint64 SvgFixCache::MaxBytes = 64 * 1024 * 1024;
+qint64 SvgFixCache::TotalBytes = -1;
+QDateTime SvgFixCache::CurrentTime;
+
+bool SvgFixCache::find(const QByteArray & contents, int fixFlags, QByteArray & fixed)
+{
+	QFile file(path(contents, fixFlags));
+	if (!file.open(QFile::ReadOnly)) return false;
+
+	// an empty entry records that the cleanup left the file alone
+	fixed = file.readAll();
+	if (fixed.isEmpty()) {
+		fixed = contents;
+	}
+
+	// the modification time doubles as the last use for eviction; only refresh stale ones so hits stay read-only
+	QDateTime now = currentTime();
+	if (file.fileTime(QFileDevice::FileModificationTime).secsTo(now) > TouchIntervalSecs) {
+		file.setFileTime(now, QFileDevice::FileModificationTime);
+	}
+	return true;
+}
+
+void SvgFixCache::insert(const QByteArray & contents, int fixFlags, const QByteArray & fixed, bool changed)
+{
+	QString filename = path(contents, fixFlags);
+	if (filename.isEmpty()) return;
+
+	QDir().mkpath(folder());
+	QFile file(filename);
+	if (!file.open(QFile::WriteOnly | QFile::Truncate)) return;
+
+	if (changed) {
+		file.write(fixed);
+	}
+	file.flush();
+	file.setFileTime(currentTime(), QFileDevice::FileModificationTime);
+	file.close();
+
+	if (TotalBytes < 0) {
+		scan();
+	}
+	else {
+		TotalBytes += file.size();
+	}
+
+	if (TotalBytes > MaxBytes) {
+		evict();
+	}
+}
+
+void SvgFixCache::setFolder(const QString & folder)
+{
+	Folder = folder;
+	TotalBytes = -1;
+}
+
+const QString & SvgFixCache::folder()
+{
+	if (Folder.isEmpty()) {
+		Folder = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/svg";
+	}
+	return Folder;
+}
+
+void SvgFixCache::setMaxBytes(qint64 maxBytes)
+{
+	MaxBytes = maxBytes;
+}
+
+qint64 SvgFixCache::maxBytes()
+{
+	return MaxBytes;
+}
+
+void SvgFixCache::clear()
+{
+	QDir dir(folder());
+	Q_FOREACH (QString filename, dir.entryList(QStringList("*" + CacheSuffix), QDir::Files)) {
+		dir.remove(filename);
+	}
+	TotalBytes = 0;
+}
+
+void SvgFixCache::setCurrentTime(const QDateTime & currentTime)
+{
+	CurrentTime = currentTime;
+}
+
+QDateTime SvgFixCache::currentTime()
+{
+	return CurrentTime.isValid() ? CurrentTime : QDateTime::currentDateTime();
+}
+
+QString SvgFixCache::path(const QByteArray & contents, int fixFlags)
+{
+	if (contents.isEmpty()) return QString();
+
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	hash.addData(FixVersion);
+	hash.addData(QByteArray::number(fixFlags) + ':');
+	hash.addData(contents);
+	return folder() + "/" + QString::fromLatin1(hash.result().toHex()) + CacheSuffix;
+}
+
+void SvgFixCache::scan()
+{
+	TotalBytes = 0;
+	QDir dir(folder());
+	Q_FOREACH (QFileInfo fileInfo, dir.entryInfoList(QStringList("*" + CacheSuffix), QDir::Files)) {
+		TotalBytes += fileInfo.size();
+	}
+}
+
+void SvgFixCache::evict()
+{
+	// drop the least recently used entries until there is a quarter of the budget to spare,
+	// so a steady stream of new parts does not rescan the folder on every insert
+	QDir dir(folder());
+	QFileInfoList fileInfos = dir.entryInfoList(QStringList("*" + CacheSuffix), QDir::Files, QDir::Time);
+	qint64 target = MaxBytes - (MaxBytes / 4);
+	while (TotalBytes > target && !fileInfos.isEmpty()) {
+		QFileInfo fileInfo = fileInfos.takeLast();
+		if (QFile::remove(fileInfo.absoluteFilePath())) {
+			TotalBytes -= fileInfo.size();
+		}
+	}
+}
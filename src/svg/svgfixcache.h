@@ -0,0 +1,65 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef SVGFIXCACHE_H
+#define SVGFIXCACHE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QDateTime>
+
+class SvgFixCache
+{
+	// Keeps the output of the load-time svg cleanup (TextUtils::fixMuch and fixPixelDimensionsIn) on disk,
+	// keyed by a hash of the unfixed bytes and the fixes applied, so part files that have not changed skip the cleanup
+	// on later launches. The folder is bounded by maxBytes(); the least recently used entries are evicted first.
+	// Bump FixVersion whenever the cleanup itself changes. Not thread safe.
+
+public:
+	enum FixFlag {
+		FixMuch = 0x01,
+		FixStrokeWidth = 0x02,		// fixMuch(svg, true)
+		FixPixelDimensions = 0x04
+	};
+
+public:
+	static bool find(const QByteArray & contents, int fixFlags, QByteArray & fixed);
+	static void insert(const QByteArray & contents, int fixFlags, const QByteArray & fixed, bool changed);
+	static void setFolder(const QString & folder);
+	static const QString & folder();
+	static void setMaxBytes(qint64);
+	static qint64 maxBytes();
+	static void clear();
+	static void setCurrentTime(const QDateTime &);	// for tests; an invalid time means the system clock
+
+protected:
+	static QString path(const QByteArray & contents, int fixFlags);
+	static QDateTime currentTime();
+	static void scan();
+	static void evict();
+
+protected:
+	static QString Folder;
+	static qint64 MaxBytes;
+	static qint64 TotalBytes;
+	static QDateTime CurrentTime;
+};
+
+#endif
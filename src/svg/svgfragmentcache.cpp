@@ -0,0 +1,72 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "svgfragmentcache.h"
+
+static constexpr qint64 MaxCharacters = 32 * 1024 * 1024;
+static const QChar KeySeparator('\n');
+
+QCache<QString, SvgFragmentCache::Fragment> SvgFragmentCache::Cache(MaxCharacters);
+
+QString SvgFragmentCache::key(const QString & filename, const QString & moduleID, ViewLayer::ViewLayerID viewLayerID, ViewLayer::ViewLayerPlacement viewLayerPlacement,
+                              Qt::Orientations orientation, double dpi, bool blackOnly, bool rubberBand)
+{
+	// the module id comes first so invalidate() can match on it
+	return moduleID + KeySeparator + filename + KeySeparator + QString("%1 %2 %3 %4 %5 %6")
+	       .arg(viewLayerID)
+	       .arg(viewLayerPlacement)
+	       .arg(orientation)
+	       .arg(dpi)
+	       .arg(blackOnly)
+	       .arg(rubberBand);
+}
+
+bool SvgFragmentCache::find(const QString & key, QString & svg, double & factor)
+{
+	Fragment * fragment = Cache.object(key);
+	if (fragment == nullptr) return false;
+
+	svg = fragment->svg;
+	factor = fragment->factor;
+	return true;
+}
+
+void SvgFragmentCache::insert(const QString & key, const QString & svg, double factor)
+{
+	auto * fragment = new Fragment;
+	fragment->svg = svg;
+	fragment->factor = factor;
+	Cache.insert(key, fragment, qMax<qsizetype>(1, svg.length()));
+}
+
+void SvgFragmentCache::invalidate(const QString & moduleID)
+{
+	QString prefix = moduleID + KeySeparator;
+	Q_FOREACH (QString key, Cache.keys()) {
+		if (key.startsWith(prefix)) {
+			Cache.remove(key);
+		}
+	}
+}
+
+void SvgFragmentCache::clear()
+{
+	Cache.clear();
+}
@@ -0,0 +1,54 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef SVGFRAGMENTCACHE_H
+#define SVGFRAGMENTCACHE_H
+
+#include <QString>
+#include <QCache>
+
+#include "../viewlayer.h"
+
+class SvgFragmentCache
+{
+	// Holds the normalized per-layer fragments PaletteItemBase::retrieveSvg() builds for gerber and svg export,
+	// DRC, autorouting and ground fill, so repeated exports of a board do not split and normalize every part again.
+	// The key covers the part file and everything the normalization depends on, but not the file's contents:
+	// part files are not rewritten in place, and the part swap and property change paths call invalidate().
+
+public:
+	static QString key(const QString & filename, const QString & moduleID, ViewLayer::ViewLayerID, ViewLayer::ViewLayerPlacement,
+	                   Qt::Orientations, double dpi, bool blackOnly, bool rubberBand);
+	static bool find(const QString & key, QString & svg, double & factor);
+	static void insert(const QString & key, const QString & svg, double factor);
+	static void invalidate(const QString & moduleID);
+	static void clear();
+
+protected:
+	struct Fragment {
+		QString svg;
+		double factor;
+	};
+
+protected:
+	static QCache<QString, Fragment> Cache;
+};
+
+#endif
@@ -0,0 +1,122 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "svglayercache.h"
+#include "svgfilesplitter.h"
+#include "../model/modelpart.h"
+#include "../items/partfactory.h"
+#include "../debugdialog.h"
+
+#include <QSet>
+#include <QElapsedTimer>
+#include <QtConcurrentMap>
+
+QHash<QString, QByteArray> SvgLayerCache::Cache;
+
+void SvgLayerCache::prepare(const QList<ModelPart *> & modelParts)
+{
+	QElapsedTimer elapsedTimer;
+	elapsedTimer.start();
+
+	// resolving filenames can generate svgs (mystery parts, headers, etc.), so do it on this thread
+	QList<Job> jobs;
+	QSet<QString> moduleIDs;
+	QSet<QString> keys;
+	QList<ViewLayer::ViewID> viewIDs;
+	viewIDs << ViewLayer::BreadboardView << ViewLayer::SchematicView << ViewLayer::PCBView;
+	Q_FOREACH (ModelPart * modelPart, modelParts) {
+		ModelPartShared * modelPartShared = modelPart->modelPartShared();
+		if (modelPartShared == nullptr) continue;
+		if (moduleIDs.contains(modelPart->moduleID())) continue;
+
+		moduleIDs.insert(modelPart->moduleID());
+		Q_FOREACH (ViewLayer::ViewID viewID, viewIDs) {
+			bool multipleLayers = modelPartShared->hasMultipleLayers(viewID);
+			Q_FOREACH (ViewLayer::ViewLayerID viewLayerID, modelPartShared->viewLayers(viewID)) {
+				bool split = viewLayerID != ViewLayer::Schematic && viewLayerID != ViewLayer::SchematicText;
+				if (split && !multipleLayers) {
+					// a single layer file is loaded directly; nothing to gain
+					continue;
+				}
+
+				QString imageFilename = modelPartShared->imageFileName(viewID, viewLayerID);
+				QString filename = PartFactory::getSvgFilename(modelPart, imageFilename, true, true);
+				if (filename.isEmpty()) continue;
+
+				QString k = key(filename, viewLayerID);
+				if (keys.contains(k)) continue;
+
+				keys.insert(k);
+				Job job;
+				job.filename = filename;
+				job.viewLayerID = viewLayerID;
+				jobs.append(job);
+			}
+		}
+	}
+
+	QtConcurrent::blockingMap(jobs, &SvgLayerCache::run);
+
+	Q_FOREACH (const Job & job, jobs) {
+		Cache.insert(key(job.filename, job.viewLayerID), job.bytes);
+	}
+
+	DebugDialog::debug(QString("prepared %1 svg layers for %2 parts in %3 ms").arg(jobs.count()).arg(moduleIDs.count()).arg(elapsedTimer.elapsed()));
+}
+
+void SvgLayerCache::run(Job & job)
+{
+	// runs on a pool thread: touches nothing but the file and its own job
+	if (job.viewLayerID == ViewLayer::Schematic) {
+		job.bytes = SvgFileSplitter::hideText(job.filename);
+	}
+	else if (job.viewLayerID == ViewLayer::SchematicText) {
+		bool hasText = false;
+		job.bytes = SvgFileSplitter::showText(job.filename, hasText);
+		if (!hasText) {
+			job.bytes.clear();
+		}
+	}
+	else {
+		SvgFileSplitter svgFileSplitter;
+		if (svgFileSplitter.split(job.filename, ViewLayer::viewLayerXmlNameFromID(job.viewLayerID))) {
+			job.bytes = svgFileSplitter.byteArray();
+		}
+	}
+}
+
+bool SvgLayerCache::find(const QString & filename, ViewLayer::ViewLayerID viewLayerID, QByteArray & bytes)
+{
+	auto it = Cache.constFind(key(filename, viewLayerID));
+	if (it == Cache.constEnd()) return false;
+
+	bytes = it.value();
+	return true;
+}
+
+void SvgLayerCache::clear()
+{
+	Cache.clear();
+}
+
+QString SvgLayerCache::key(const QString & filename, ViewLayer::ViewLayerID viewLayerID)
+{
+	return QString("%1\n%2").arg(filename).arg((int) viewLayerID);
+}
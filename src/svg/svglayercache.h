@@ -0,0 +1,57 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef SVGLAYERCACHE_H
+#define SVGLAYERCACHE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+
+#include "../viewlayer.h"
+
+class SvgLayerCache
+{
+	// Holds the per-layer svg fragments of every distinct part in a sketch while it is being loaded.
+	// The fragments are split out of the part files concurrently before any item is created,
+	// so ItemBase::setUpImage() does not have to read and parse the same file once per instance.
+	// Only valid for the duration of a load: call clear() when the items have been created.
+
+public:
+	static void prepare(const QList<class ModelPart *> &);
+	static bool find(const QString & filename, ViewLayer::ViewLayerID, QByteArray & bytes);
+	static void clear();
+
+protected:
+	struct Job {
+		QString filename;
+		ViewLayer::ViewLayerID viewLayerID;
+		QByteArray bytes;
+	};
+
+	static void run(Job &);
+	static QString key(const QString & filename, ViewLayer::ViewLayerID);
+
+protected:
+	static QHash<QString, QByteArray> Cache;
+};
+
+#endif
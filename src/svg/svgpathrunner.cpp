@@ -34,40 +34,24 @@ SVGPathRunner::~SVGPathRunner()
 {
 }
 
-bool SVGPathRunner::runPath(QVector<QVariant> & pathData, void * userData) {
-	PathCommand * currentCommand = nullptr;
+bool SVGPathRunner::runPath(const SVGPathData & pathData, void * userData) {
 	QList<double> args;
 
-	Q_FOREACH (QVariant variant, pathData) {
-		if (variant.typeId() == QMetaType::QChar) {
-			PathCommand * newCommand = pathCommands.value(variant.toChar(), nullptr);
-			if (newCommand == nullptr) return false;
+	for (const SVGPathData::Command & command : pathData.commands) {
+		PathCommand * pathCommand = pathCommands.value(command.command, nullptr);
+		if (pathCommand == nullptr) return false;
 
-			if (currentCommand != nullptr) {
-				if (currentCommand->argCount == 0) {
-					if (args.count() != 0) return false;
-				}
-				else if (args.count() % currentCommand->argCount != 0) return false;
-
-				Q_EMIT commandSignal(currentCommand->command, currentCommand->relative, args, userData);
-			}
-
-			args.clear();
-			currentCommand = newCommand;
+		if (pathCommand->argCount == 0) {
+			if (command.argCount != 0) return false;
 		}
-		else if (variant.typeId() == QMetaType::Double) {
-			if (currentCommand == nullptr) return false;
-			args.append(variant.toDouble());
-		}
-	}
+		else if (command.argCount % pathCommand->argCount != 0) return false;
 
-	if (currentCommand != nullptr) {
-		if (currentCommand->argCount == 0) {
-			if (args.count() != 0) return false;
+		args.clear();
+		for (int i = 0; i < command.argCount; i++) {
+			args.append(pathData.args.at(command.argStart + i));
 		}
-		else if (args.count() % currentCommand->argCount != 0) return false;
 
-		Q_EMIT commandSignal(currentCommand->command, currentCommand->relative, args, userData);
+		Q_EMIT commandSignal(pathCommand->command, pathCommand->relative, args, userData);
 	}
 
 	return true;
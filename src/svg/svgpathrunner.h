@@ -24,6 +24,8 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QVariant>
 #include <QVector>
 
+#include "svgpathscanner.h"
+
 struct PathCommand {
 	bool relative;
 	int argCount;
@@ -39,7 +41,7 @@ public:
 	~SVGPathRunner();
 
 public:
-	bool runPath(QVector<QVariant> & pathData, void * userData);
+	bool runPath(const SVGPathData & pathData, void * userData);
 
 Q_SIGNALS:
 	// note: must connect to this signal via Qt::DirectConnection since args is modified immediately after the signal
@@ -0,0 +1,181 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#include "svgpathscanner.h"
+#include "svgpathlexer.h"
+
+static inline bool isDigit(const QChar * chars, int pos, int size) {
+	return pos < size && chars[pos].unicode() >= '0' && chars[pos].unicode() <= '9';
+}
+
+static inline bool isSign(QChar c) {
+	return c == QLatin1Char('-') || c == QLatin1Char('+');
+}
+
+/**
+ * Matches the same numbers as TextUtils::RegexFloatDetector
+ * @return the position following the number, or start if there is no number there
+ */
+static int scanNumber(const QChar * chars, int start, int size) {
+	int pos = start;
+	if (pos < size && isSign(chars[pos])) pos++;
+
+	bool mantissa = false;
+	while (isDigit(chars, pos, size)) {
+		pos++;
+		mantissa = true;
+	}
+	if (pos < size && chars[pos] == QLatin1Char('.') && isDigit(chars, pos + 1, size)) {
+		pos += 2;
+		while (isDigit(chars, pos, size)) pos++;
+		mantissa = true;
+	}
+	if (!mantissa) return start;
+
+	if (pos < size && (chars[pos] == QLatin1Char('e') || chars[pos] == QLatin1Char('E'))) {
+		int exponent = pos + 1;
+		if (exponent < size && isSign(chars[exponent])) exponent++;
+		if (isDigit(chars, exponent, size)) {
+			pos = exponent;
+			while (isDigit(chars, pos, size)) pos++;
+		}
+	}
+
+	return pos;
+}
+
+void SVGPathData::clear() {
+	commands.clear();
+	args.clear();
+}
+
+bool SVGPathData::isEmpty() const {
+	return commands.isEmpty();
+}
+
+int SVGPathScanner::argCount(QChar command) {
+	switch (command.toLatin1()) {
+	case 'M':
+	case 'm':
+	case 'L':
+	case 'l':
+	case 'T':
+	case 't':
+		return 2;
+	case 'H':
+	case 'h':
+	case 'V':
+	case 'v':
+		return 1;
+	case 'C':
+	case 'c':
+		return 6;
+	case 'S':
+	case 's':
+	case 'Q':
+	case 'q':
+		return 4;
+	case 'A':
+	case 'a':
+		return 7;
+	case 'Z':
+	case 'z':
+	case SVGPathLexer::FakeClosePathChar:
+		return 0;
+	default:
+		return -1;
+	}
+}
+
+bool SVGPathScanner::scan(QStringView source, SVGPathData & data)
+{
+	data.clear();
+
+	const QChar * chars = source.data();
+	int size = source.size();
+	int pos = 0;
+	int groupSize = -1;          // arguments per repetition of the current command; -1 before the first command
+	int currentArgs = 0;         // arguments collected for the current command
+	bool afterNumber = false;
+	bool afterComma = false;
+
+	auto commandComplete = [&]() {
+		if (groupSize < 0) return true;
+		if (groupSize == 0) return currentArgs == 0;
+		return currentArgs > 0 && currentArgs % groupSize == 0;
+	};
+
+	while (pos < size) {
+		QChar c = chars[pos];
+		if (c.isSpace()) {
+			pos++;
+			continue;
+		}
+
+		if (c == QLatin1Char(',')) {
+			// a comma may only separate two numbers
+			if (!afterNumber || afterComma) break;
+
+			afterComma = true;
+			pos++;
+			continue;
+		}
+
+		int end = scanNumber(chars, pos, size);
+		if (end > pos) {
+			if (groupSize <= 0) break;
+
+			data.args.append(QStringView(chars + pos, end - pos).toDouble());
+			data.commands.last().argCount++;
+			currentArgs++;
+			afterNumber = true;
+			afterComma = false;
+			pos = end;
+			continue;
+		}
+
+		int count = argCount(c);
+		if (count < 0 || afterComma || !commandComplete()) break;
+
+		if (groupSize < 0 && c != QLatin1Char('M') && c != QLatin1Char('m')) {
+			// the path must start with a moveto
+			break;
+		}
+
+		if (c != QLatin1Char(SVGPathLexer::FakeClosePathChar)) {
+			SVGPathData::Command command;
+			command.command = c;
+			command.argStart = data.args.count();
+			data.commands.append(command);
+		}
+
+		groupSize = count;
+		currentArgs = 0;
+		afterNumber = false;
+		pos++;
+	}
+
+	if (pos < size || afterComma || groupSize < 0 || !commandComplete()) {
+		data.clear();
+		return false;
+	}
+
+	return true;
+}
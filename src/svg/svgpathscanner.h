@@ -0,0 +1,65 @@
+/*******************************************************************
+
+Part of the Fritzing project - http://fritzing.org
+Copyright (c) 2007-2019 Fritzing
+
+Fritzing is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Fritzing is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************/
+
+#ifndef SVGPATHSCANNER_H
+#define SVGPATHSCANNER_H
+
+#include <QChar>
+#include <QStringView>
+#include <QVector>
+
+/**
+ * Parsed svg path data: one entry per path command, with all the command
+ * arguments kept in a single flat array.
+ */
+class SVGPathData
+{
+public:
+	struct Command {
+		QChar command;
+		int argStart = 0;
+		int argCount = 0;
+	};
+
+public:
+	void clear();
+	bool isEmpty() const;
+
+public:
+	QVector<Command> commands;
+	QVector<double> args;
+};
+
+/**
+ * Hand-written replacement for SVGPathLexer + SVGPathParser.
+ *
+ * Accepts the same path data as the grammar in svgpath.g (a path must start
+ * with a moveto, every command needs whole groups of arguments, and the
+ * trailing SVGPathLexer::FakeClosePathChar is dropped), but scans the string
+ * in place instead of cleaning it up with regular expressions first.
+ */
+class SVGPathScanner
+{
+public:
+	static bool scan(QStringView source, SVGPathData & data);
+	static int argCount(QChar command);
+};
+
+#endif // SVGPATHSCANNER_H
@@ -28,6 +28,13 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QMutex>
 #include <QMutexLocker>
 #include <QDateTime>
+#include <QFuture>
+#include <QtConcurrentRun>
+
+#ifdef Q_OS_UNIX
+#include <sys/file.h>
+#include <cerrno>
+#endif
 
 const QString LockManager::LockedFileName = "___lockfile___.txt";
 const long LockManager::FastTime =  2000;
@@ -38,6 +45,12 @@ static QHash<long, QPointer<QTimer> > TheTimers;
 static QMultiHash<long, LockedFile *> TheLockedFiles;
 static QMutex LockedFilesMutex;
 static QMutex TimersMutex;
+static QList<QFuture<void> > TheBackgroundJobs;
+static QMutex BackgroundJobsMutex;
+
+static bool recentlyTouched(const QFileInfo & info, long touchFrequency) {
+	return info.lastModified() >= QDateTime::currentDateTime().addMSecs(-2000 - touchFrequency);
+}
 
 LockedFile::LockedFile(const QString & filename, long freq) {
 	file.setFileName(filename);
@@ -45,6 +58,9 @@ LockedFile::LockedFile(const QString & filename, long freq) {
 }
 
 bool LockedFile::touch() {
+	// reopening would drop the advisory lock, so only bump the time through the open handle
+	if (locked) return file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+
 	if (file.open(QFile::WriteOnly)) {
 		file.write("a");
 		file.close();
@@ -54,6 +70,28 @@ bool LockedFile::touch() {
 	return false;
 }
 
+bool LockedFile::lock() {
+	// the lock is held for as long as the file stays open, and the OS drops it if we crash
+#ifdef Q_OS_UNIX
+	if (!file.open(QFile::ReadWrite)) return false;
+
+	if (::flock(file.handle(), LOCK_EX | LOCK_NB) != 0) {
+		// other failures (ENOLCK on some network drives) say nothing about ownership
+		contended = (errno == EWOULDBLOCK);
+		file.close();
+		return false;
+	}
+
+	file.resize(0);
+	file.write("a");
+	file.flush();
+	locked = true;
+	return true;
+#else
+	return false;
+#endif
+}
+
 /////////////////////////////////////////////////
 
 LockManager::LockManager() : QObject()
@@ -75,16 +113,34 @@ void LockManager::cleanup() {
 		}
 	}
 	TheTimers.clear();
+
+	QMutexLocker jobsLocker(&BackgroundJobsMutex);
+	Q_FOREACH (QFuture<void> future, TheBackgroundJobs) {
+		future.waitForFinished();
+	}
+	TheBackgroundJobs.clear();
+}
+
+void LockManager::runInBackground(const std::function<void()> & function) {
+	QMutexLocker locker(&BackgroundJobsMutex);
+	for (int i = TheBackgroundJobs.count() - 1; i >= 0; i--) {
+		if (TheBackgroundJobs.at(i).isFinished()) TheBackgroundJobs.removeAt(i);
+	}
+	TheBackgroundJobs.append(QtConcurrent::run(function));
 }
 
 void LockManager::touchFiles() {
 	auto * timer = qobject_cast<QTimer *>(sender());
 	if (timer == nullptr) return;
 
-	QMutexLocker locker(&LockedFilesMutex);
-	Q_FOREACH (LockedFile * lockedFile, TheLockedFiles.values(timer->interval())) {
-		lockedFile->touch();
-	}
+	// rewriting the lock files can stall on slow or network drives, so keep it off the gui thread
+	long interval = timer->interval();
+	runInBackground([interval]() {
+		QMutexLocker locker(&LockedFilesMutex);
+		Q_FOREACH (LockedFile * lockedFile, TheLockedFiles.values(interval)) {
+			lockedFile->touch();
+		}
+	});
 }
 
 void LockManager::initLockedFiles(const QString & prefix, QString & folder, QHash<QString, LockedFile *> & lockedFiles, long touchFrequency) {
@@ -102,22 +158,51 @@ void LockManager::initLockedFiles(const QString & prefix, QString & folder, QHas
 
 LockedFile * LockManager::makeLockedFile(const QString & path, long touchFrequency) {
 	auto * lockedFile = new LockedFile(path, touchFrequency);
+	if (!lockedFile->lock()) {
+		lockedFile->touch();
+	}
+	registerLockedFile(lockedFile);
+	return lockedFile;
+}
+
+LockedFile * LockManager::claimLockedFile(const QString & path, long touchFrequency) {
+	// returns nullptr if another process still owns the folder
+	QFileInfo lockInfo(path);
+	if (lockInfo.exists() && recentlyTouched(lockInfo, touchFrequency)) {
+		// its owner is still touching it
+		return nullptr;
+	}
+
+	auto * lockedFile = new LockedFile(path, touchFrequency);
+	if (lockedFile->lock()) return lockedFile;
+
+	if (lockedFile->contended) {
+		// somebody else holds the advisory lock
+		delete lockedFile;
+		return nullptr;
+	}
+
+	// no advisory locks here: the stale time decides, as it always has
 	lockedFile->touch();
+	return lockedFile;
+}
+
+void LockManager::registerLockedFile(LockedFile * lockedFile) {
 	LockedFilesMutex.lock();
-	TheLockedFiles.insert(touchFrequency, lockedFile);
+	TheLockedFiles.insert(lockedFile->frequency, lockedFile);
 	LockedFilesMutex.unlock();
 
+	// advisory locks protect us from this version, but older releases only look at the modification time
 	QMutexLocker locker(&TimersMutex);
-	QTimer * timer = TheTimers.value(touchFrequency, nullptr);
+	QTimer * timer = TheTimers.value(lockedFile->frequency, nullptr);
 	if (timer == nullptr) {
 		timer = new QTimer();
-		timer->setInterval(touchFrequency);
+		timer->setInterval(lockedFile->frequency);
 		timer->setSingleShot(false);
 		QObject::connect(timer, SIGNAL(timeout()), &TheLockManager, SLOT(touchFiles()));
 		timer->start();
-		TheTimers.insert(touchFrequency, timer);
+		TheTimers.insert(lockedFile->frequency, timer);
 	}
-	return lockedFile;
 }
 
 
@@ -140,10 +225,10 @@ void LockManager::releaseLockedFiles(const QString & folder, QHash<QString, Lock
 		LockedFilesMutex.lock();
 		TheLockedFiles.remove(lockedFile->frequency, lockedFile);
 		LockedFilesMutex.unlock();
+		delete lockedFile;
 		if (remove) {
 			FolderUtils::rmdir(backupDir.absoluteFilePath(sub));
 		}
-		delete lockedFile;
 	}
 	lockedFiles.clear();
 }
@@ -155,6 +240,7 @@ void LockManager::checkLockedFiles(const QString & prefix, QFileInfoList & backu
 		DebugDialog::debug(QString("Error, lock directory not found: %1 %2").arg(backupDir.absolutePath(), prefix));
 		return;
 	}
+	QStringList staleFolders;
 	QFileInfoList dirList = backupDir.entryInfoList(QDir::AllDirs | QDir::NoDotAndDotDot | QDir::Hidden | QDir::NoSymLinks);
 	Q_FOREACH (QFileInfo dirInfo, dirList) {
 		QDir dir(dirInfo.filePath());
@@ -170,31 +256,75 @@ void LockManager::checkLockedFiles(const QString & prefix, QFileInfoList & backu
 			// could mean this backup folder is just being created by another process
 			// could also mean it's leftover crap.
 			// check the date and only delete if it's old
-
-			QDateTime lastModified = dirInfo.lastModified();
-			if (lastModified < QDateTime::currentDateTime().addMSecs(-2000 - touchFrequency)) {
-				FolderUtils::rmdir(dirInfo.filePath());
+			if (!recentlyTouched(dirInfo, touchFrequency)) {
+				staleFolders << dirInfo.filePath();
 			}
 
 			continue;
 		}
 
-		QFileInfo lockInfo(dir.absoluteFilePath(LockedFileName));
-		if (lockInfo.exists()) {
-			QDateTime lastModified = lockInfo.lastModified();
-			if (lastModified >= QDateTime::currentDateTime().addMSecs(-2000 - touchFrequency)) {
-				// somebody else owns the file
-				continue;
-			}
+		LockedFile * lockedFile = claimLockedFile(dir.absoluteFilePath(LockedFileName), touchFrequency);
+		if (lockedFile == nullptr) {
+			// somebody else owns the file
+			continue;
 		}
 
 		// we own the file
-		LockedFile * lockedFile = makeLockedFile(dir.absoluteFilePath(LockedFileName), touchFrequency);
+		registerLockedFile(lockedFile);
 		lockedFiles.insert(dirInfo.fileName(), lockedFile);
 		Q_FOREACH (QFileInfo fileInfo, fileInfoList) {
 			backupList << fileInfo;
 		}
 	}
+
+	if (!staleFolders.isEmpty()) {
+		DebugDialog::debug(QString("removing %1 stale %2 folders").arg(staleFolders.count()).arg(prefix));
+		runInBackground([staleFolders]() {
+			Q_FOREACH (QString path, staleFolders) {
+				QDir(path).removeRecursively();
+			}
+		});
+	}
+}
+
+void LockManager::removeStaleFolders(const QString & prefix, bool recurse, long touchFrequency)
+{
+	// for callers that only want leftovers from crashed sessions gone: scan and delete on a worker
+	// rather than claiming the folders and deleting them at exit
+	QDir backupDir(FolderUtils::getTopLevelUserDataStorePath());
+	if (! backupDir.cd(prefix)) {
+		DebugDialog::debug(QString("Error, lock directory not found: %1 %2").arg(backupDir.absolutePath(), prefix));
+		return;
+	}
+
+	QString path = backupDir.absolutePath();
+	runInBackground([path, recurse, touchFrequency]() {
+		QDir backupDir(path);
+		QFileInfoList dirList = backupDir.entryInfoList(QDir::AllDirs | QDir::NoDotAndDotDot | QDir::Hidden | QDir::NoSymLinks);
+		Q_FOREACH (QFileInfo dirInfo, dirList) {
+			QDir dir(dirInfo.filePath());
+			QStringList filters;
+			QFileInfoList fileInfoList = dir.entryInfoList(filters, QDir::Files | QDir::Hidden | QDir::NoSymLinks);
+			bool gotRecurse = false;
+			if (recurse && fileInfoList.isEmpty()) {
+				gotRecurse = checkLockedFilesAux(dir, filters);
+			}
+
+			if (fileInfoList.isEmpty() && !gotRecurse) {
+				if (!recentlyTouched(dirInfo, touchFrequency)) {
+					dir.removeRecursively();
+				}
+				continue;
+			}
+
+			LockedFile * lockedFile = claimLockedFile(dir.absoluteFilePath(LockedFileName), touchFrequency);
+			if (lockedFile == nullptr) continue;
+
+			// close the lock file first so the folder can also be removed on Windows
+			delete lockedFile;
+			dir.removeRecursively();
+		}
+	});
 }
 
 bool LockManager::checkLockedFilesAux(const QDir & parent, QStringList & filters)
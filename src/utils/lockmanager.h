@@ -25,13 +25,18 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QHash>
 #include <QFileInfoList>
 
+#include <functional>
+
 
 struct LockedFile {
 	QFile file;
 	long frequency;
+	bool locked = false;	// held with an advisory lock; still touched for releases that only check the time
+	bool contended = false;	// the last lock() failed because another process holds the lock
 
 	LockedFile(const QString & filename, long freq);
 	bool touch();
+	bool lock();
 };
 
 class LockManager : public QObject {
@@ -45,6 +50,7 @@ public:
 	static void initLockedFiles(const QString & prefix, QString & folder, QHash<QString, LockedFile *> & lockedFiles, long touchFrequency);
 	static void releaseLockedFiles(const QString & folder, QHash<QString, LockedFile *> & lockedFiles);
 	static void checkLockedFiles(const QString & prefix, QFileInfoList & backupList, QHash<QString, LockedFile *> & lockedFiles, bool recurse, long touchFrequency);
+	static void removeStaleFolders(const QString & prefix, bool recurse, long touchFrequency);
 	static void cleanup();
 
 public:
@@ -59,6 +65,9 @@ protected:
 	static bool checkLockedFilesAux(const QDir & parent, QStringList & filters);
 	static void releaseLockedFiles(const QString & folder, QHash<QString, LockedFile *> & lockedFiles, bool remove);
 	static LockedFile * makeLockedFile(const QString & folder, long touchFrequency);
+	static LockedFile * claimLockedFile(const QString & path, long touchFrequency);
+	static void registerLockedFile(LockedFile * lockedFile);
+	static void runInBackground(const std::function<void()> & function);
 
 };
 
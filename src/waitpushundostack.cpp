@@ -24,6 +24,62 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <QCoreApplication>
 #include <QTextStream>
+#include <QSettings>
+
+const int WaitPushUndoStack::DefaultMemoryBudgetMB = 64;
+const qint64 SpillableString::MinSpillSize = 4096;
+
+/////////////////////////////////
+
+qint64 UndoSpillFile::write(const QString & string) {
+	if (!m_file.isOpen() && !m_file.open()) return -1;
+
+	qint64 offset = m_file.size();
+	if (!m_file.seek(offset)) return -1;
+
+	qint64 size = string.size() * (qint64) sizeof(QChar);
+	if (m_file.write((const char *) string.constData(), size) != size) return -1;
+
+	return offset;
+}
+
+QString UndoSpillFile::read(qint64 offset, qint64 size) {
+	if (!m_file.isOpen() || !m_file.seek(offset)) return QString();
+
+	QByteArray bytes = m_file.read(size);
+	return QString((const QChar *) bytes.constData(), bytes.size() / sizeof(QChar));
+}
+
+/////////////////////////////////
+
+SpillableString::SpillableString(const QString & value) : m_value(value)
+{
+}
+
+QString SpillableString::value() const {
+	if (m_offset < 0) return m_value;
+
+	// leave it on disk: a spilled command is old and rarely undone more than once
+	return m_spillFile->read(m_offset, m_size);
+}
+
+qint64 SpillableString::memoryFootprint() const {
+	return m_value.size() * (qint64) sizeof(QChar);
+}
+
+qint64 SpillableString::spill(const QSharedPointer<UndoSpillFile> & spillFile) {
+	qint64 footprint = memoryFootprint();
+	if (m_offset >= 0 || footprint < MinSpillSize) return 0;
+
+	qint64 offset = spillFile->write(m_value);
+	if (offset < 0) return 0;
+
+	m_spillFile = spillFile;
+	m_offset = offset;
+	m_size = footprint;
+	m_value = QString();
+	return footprint;
+}
 
 CommandTimer::CommandTimer(QUndoCommand * command, int delayMS, WaitPushUndoStack * undoStack) : QTimer()
 {
@@ -49,6 +105,11 @@ WaitPushUndoStack::WaitPushUndoStack(QObject * parent) :
 	QUndoStack(parent)
 {
 	m_temporary = nullptr;
+	m_spillFile = QSharedPointer<UndoSpillFile>(new UndoSpillFile());
+
+	QSettings settings;
+	setMemoryBudget(settings.value("undoMemoryBudgetMB", DefaultMemoryBudgetMB).toLongLong() * 1024 * 1024);
+
 #ifndef QT_NO_DEBUG
 	QString path = FolderUtils::getTopLevelUserDataStorePath();
 	path += "/undostack.txt";
@@ -73,7 +134,59 @@ void WaitPushUndoStack::push(QUndoCommand * cmd)
 		return;
 	}
 
+	int oldIndex = index();
 	QUndoStack::push(cmd);
+	updateMemoryFootprint(oldIndex);
+	enforceMemoryBudget();
+}
+
+void WaitPushUndoStack::setMemoryBudget(qint64 bytes) {
+	// zero means unbounded
+	m_memoryBudget = qMax(bytes, (qint64) 0);
+}
+
+qint64 WaitPushUndoStack::memoryBudget() const {
+	return m_memoryBudget;
+}
+
+qint64 WaitPushUndoStack::memoryFootprint() const {
+	return m_memoryFootprint;
+}
+
+void WaitPushUndoStack::updateMemoryFootprint(int oldIndex) {
+	// footprints are kept per stack position with a running total, so a push costs
+	// only the commands it touches: the redo tail the push discarded, the top command
+	// if the new one was merged into it, and the newly appended command
+	int keep = qMin(count(), oldIndex);
+	while (m_footprints.count() > keep) {
+		m_memoryFootprint -= m_footprints.takeLast();
+	}
+	m_spilledCount = qMin(m_spilledCount, keep);
+
+	if (keep > 0 && keep == count()) {
+		// merged into the top command (or the new command was dropped as obsolete)
+		m_memoryFootprint -= m_footprints.last();
+		m_footprints.last() = BaseCommand::totalMemoryFootprint(command(keep - 1));
+		m_memoryFootprint += m_footprints.last();
+	}
+
+	for (int i = m_footprints.count(); i < count(); i++) {
+		qint64 footprint = BaseCommand::totalMemoryFootprint(command(i));
+		m_footprints.append(footprint);
+		m_memoryFootprint += footprint;
+	}
+}
+
+void WaitPushUndoStack::enforceMemoryBudget() {
+	if (m_memoryBudget <= 0) return;
+
+	// spill the oldest commands first, but keep the most recent one in memory
+	while (m_memoryFootprint > m_memoryBudget && m_spilledCount < count() - 1) {
+		int i = m_spilledCount++;
+		qint64 freed = BaseCommand::spillAll((QUndoCommand *) command(i), m_spillFile);
+		m_footprints[i] -= freed;
+		m_memoryFootprint -= freed;
+	}
 }
 
 
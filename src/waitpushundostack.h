@@ -26,6 +26,42 @@ along with Fritzing.  If not, see <http://www.gnu.org/licenses/>.
 #include <QMutex>
 #include <QFile>
 #include <QPointer>
+#include <QTemporaryFile>
+#include <QSharedPointer>
+#include <QList>
+
+class UndoSpillFile
+{
+public:
+	UndoSpillFile() = default;
+
+	qint64 write(const QString &);
+	QString read(qint64 offset, qint64 size);
+
+protected:
+	QTemporaryFile m_file;
+};
+
+class SpillableString
+{
+	// holds a potentially large undo payload (svg, xml) which can be moved out of memory
+	// into an UndoSpillFile once the command is old enough; value() reads it back on demand
+
+public:
+	SpillableString(const QString & value = QString());
+
+	QString value() const;
+	qint64 memoryFootprint() const;
+	qint64 spill(const QSharedPointer<UndoSpillFile> &);
+
+protected:
+	QString m_value;
+	QSharedPointer<UndoSpillFile> m_spillFile;
+	qint64 m_offset = -1;
+	qint64 m_size = 0;
+
+	static const qint64 MinSpillSize;
+};
 
 class WaitPushUndoStack : public QUndoStack
 {
@@ -43,6 +79,9 @@ public:
 	void push(QUndoCommand *);
 	bool hasTimers();
 	void waitForTimers();
+	void setMemoryBudget(qint64 bytes);
+	qint64 memoryBudget() const;
+	qint64 memoryFootprint() const;
 
 #ifndef QT_NO_DEBUG
 public:
@@ -56,12 +95,22 @@ protected:
 	void clearDeadTimers();
 	void clearLiveTimers();
 	void clearTimers(QList<QTimer *> &);
+	void updateMemoryFootprint(int oldIndex);
+	void enforceMemoryBudget();
 
 protected:
 	QList<QTimer *> m_deadTimers;
 	QList<QTimer *> m_liveTimers;
 	QMutex m_mutex;
 	QUndoCommand * m_temporary;
+	QList<qint64> m_footprints;
+	qint64 m_memoryFootprint = 0;
+	qint64 m_memoryBudget = 0;
+	int m_spilledCount = 0;
+	QSharedPointer<UndoSpillFile> m_spillFile;
+
+public:
+	static const int DefaultMemoryBudgetMB;
 };
 
 
@@ -0,0 +1,200 @@
+#define BOOST_TEST_MODULE Console Tests
+#include <boost/test/included/unit_test.hpp>
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QPlainTextEdit>
+#include <QStringDecoder>
+#include <QTextBlock>
+#include <QTimer>
+#include <QtSerialPort/QSerialPort>
+
+// Get access to the private pending buffer of Console for testing
+#define private public
+#include "program/console.h"
+#undef private
+
+#ifdef Q_OS_UNIX
+
+#include <atomic>
+#include <thread>
+#include <poll.h>
+#include <unistd.h>
+#if defined(Q_OS_MACOS)
+#include <util.h>
+#else
+#include <pty.h>
+#endif
+
+static QApplication * application()
+{
+	static int argc = 1;
+	static char name[] = "test_console";
+	static char * argv[] = { name, nullptr };
+	static QApplication * app = nullptr;
+	if (app == nullptr) {
+		if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+			qputenv("QT_QPA_PLATFORM", "offscreen");
+		}
+		app = new QApplication(argc, argv);
+	}
+	return app;
+}
+
+static const int Lines = 40000;
+static const int Scrollback = 500;
+
+static QByteArray line(int i)
+{
+	return QString("line %1 0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdef\n").arg(i, 6, 10, QChar('0')).toLatin1();
+}
+
+// a pseudo-terminal standing in for a board: the test reads the slave side through
+// QSerialPort, as ConsoleWindow does, while a thread writes to the master as fast as it can
+class PseudoTerminal
+{
+public:
+	PseudoTerminal() {
+		char name[256];
+		if (openpty(&m_master, &m_slave, name, nullptr, nullptr) == 0) {
+			m_name = QString::fromLocal8Bit(name);
+		}
+	}
+
+	~PseudoTerminal() {
+		// a reader that gave up leaves the writer blocked on a full terminal; tell it to stop
+		m_stop = true;
+		if (m_writer.joinable()) m_writer.join();
+		if (m_slave >= 0) ::close(m_slave);
+		if (m_master >= 0) ::close(m_master);
+	}
+
+	const QString & name() const {
+		return m_name;
+	}
+
+	void startWriting() {
+		m_writer = std::thread([this]() {
+			for (int i = 0; i < Lines; i++) {
+				QByteArray bytes = line(i);
+				const char * data = bytes.constData();
+				qint64 left = bytes.size();
+				while (left > 0) {
+					if (m_stop) return;
+
+					struct pollfd pfd = { m_master, POLLOUT, 0 };
+					if (poll(&pfd, 1, 100) <= 0) continue;
+
+					ssize_t n = ::write(m_master, data, left);
+					if (n <= 0) return;
+					data += n;
+					left -= n;
+				}
+			}
+		});
+	}
+
+protected:
+	int m_master = -1;
+	int m_slave = -1;
+	QString m_name;
+	std::thread m_writer;
+	std::atomic<bool> m_stop { false };
+};
+
+static qint64 totalBytes()
+{
+	qint64 total = 0;
+	for (int i = 0; i < Lines; i++) {
+		total += line(i).size();
+	}
+	return total;
+}
+
+BOOST_AUTO_TEST_CASE( console_pending_buffer_is_bounded )
+{
+	application();
+	PseudoTerminal pty;
+	BOOST_REQUIRE(!pty.name().isEmpty());
+
+	QSerialPort serial;
+	serial.setPortName(pty.name());
+	BOOST_REQUIRE(serial.open(QIODevice::ReadWrite));
+
+	Console console;
+	console.setMaximumScrollback(Scrollback);
+
+	// read without returning to the event loop, so the flush timer cannot drain the buffer
+	qint64 total = totalBytes();
+	BOOST_REQUIRE(total > 2 * Console::MaxPendingBytes);
+	qint64 received = 0;
+	pty.startWriting();
+	while (received < total && serial.waitForReadyRead(2000)) {
+		QByteArray data = serial.readAll();
+		received += data.size();
+		console.putData(data);
+		BOOST_CHECK_LE(console.pending.size(), Console::MaxPendingBytes);
+	}
+	BOOST_CHECK_EQUAL(received, total);
+
+	// only the newest bytes survive
+	BOOST_CHECK_EQUAL(console.pending.size(), Console::MaxPendingBytes);
+	BOOST_CHECK(console.pending.endsWith(line(Lines - 1)));
+
+	console.flushData();
+	BOOST_CHECK(console.pending.isEmpty());
+	BOOST_CHECK_LE(console.document()->blockCount(), Scrollback);
+}
+
+BOOST_AUTO_TEST_CASE( console_scrollback_is_capped )
+{
+	application();
+	PseudoTerminal pty;
+	BOOST_REQUIRE(!pty.name().isEmpty());
+
+	QSerialPort serial;
+	serial.setPortName(pty.name());
+	BOOST_REQUIRE(serial.open(QIODevice::ReadWrite));
+
+	Console console;
+	console.setMaximumScrollback(Scrollback);
+
+	// the way the serial monitor runs: reads and flushes both come from the event loop
+	qint64 total = totalBytes();
+	qint64 received = 0;
+	QEventLoop loop;
+	QObject::connect(&serial, &QSerialPort::readyRead, [&]() {
+		QByteArray data = serial.readAll();
+		received += data.size();
+		console.putData(data);
+		if (received >= total) {
+			QTimer::singleShot(2 * Console::FlushIntervalMS, &loop, &QEventLoop::quit);
+		}
+	});
+	QTimer::singleShot(60000, &loop, &QEventLoop::quit);
+
+	QElapsedTimer timer;
+	timer.start();
+	pty.startWriting();
+	loop.exec();
+	BOOST_TEST_MESSAGE("received " << received << " bytes in " << timer.elapsed() << " ms");
+
+	BOOST_CHECK_EQUAL(received, total);
+	BOOST_CHECK(console.pending.isEmpty());
+	BOOST_CHECK_LE(console.document()->blockCount(), Scrollback);
+
+	// the last complete line is the last one sent; the block after it is the empty line the final newline opens
+	QTextBlock last = console.document()->lastBlock();
+	BOOST_CHECK(last.text().isEmpty());
+	BOOST_CHECK_EQUAL(last.previous().text().toStdString(), QString::fromLatin1(line(Lines - 1)).trimmed().toStdString());
+}
+
+#else
+
+BOOST_AUTO_TEST_CASE( console_requires_pty )
+{
+	BOOST_TEST_MESSAGE("pseudo-terminal tests only run on Unix");
+}
+
+#endif
@@ -0,0 +1,78 @@
+#include <boost/test/unit_test.hpp>
+
+#include "svg/drillorder.h"
+#include "svg/svg2gerber.h"
+#include "utils/textutils.h"
+
+#include <QRandomGenerator>
+#include <QRegularExpression>
+
+#include <algorithm>
+
+static QList<QPoint> sorted(QList<QPoint> points)
+{
+	std::sort(points.begin(), points.end(), [](const QPoint & p, const QPoint & q) {
+		return p.x() < q.x() || (p.x() == q.x() && p.y() < q.y());
+	});
+	return points;
+}
+
+BOOST_AUTO_TEST_CASE( drillorder_line )
+{
+	// hits on a line in shuffled order: the best tour from one end walks straight along it
+	QList<QPoint> hits;
+	for (int i = 1; i <= 50; i++) {
+		hits.append(QPoint(i * 100, 0));
+	}
+	QList<QPoint> shuffled(hits);
+	std::shuffle(shuffled.begin(), shuffled.end(), *QRandomGenerator::global());
+
+	QList<QPoint> tour = DrillOrder::optimize(shuffled, QPoint(0, 0));
+	BOOST_CHECK(sorted(tour) == hits);
+	BOOST_CHECK_CLOSE(DrillOrder::travel(tour, QPoint(0, 0)), 5000.0, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE( drillorder_random )
+{
+	QRandomGenerator random(1234);
+	QList<QPoint> hits;
+	for (int i = 0; i < 2000; i++) {
+		hits.append(QPoint(random.bounded(20000), random.bounded(20000)));
+	}
+
+	QList<QPoint> tour = DrillOrder::optimize(hits, QPoint(0, 0));
+	BOOST_CHECK(sorted(tour) == sorted(hits));
+
+	double before = DrillOrder::travel(hits, QPoint(0, 0));
+	double after = DrillOrder::travel(tour, QPoint(0, 0));
+	BOOST_TEST_MESSAGE("drill travel " << before << " -> " << after);
+	BOOST_CHECK(after < before / 5);
+}
+
+BOOST_AUTO_TEST_CASE( drillorder_excellon )
+{
+	// the same hits come out of the drill file, only reordered, and the reported travel does not grow
+	QString svg;
+	QList<QPoint> expected;
+	for (int i = 0; i < 10; i++) {
+		int x = (i % 2 == 0) ? 100 + (i * 50) : 900 - (i * 50);
+		svg += QString("<circle fill='black' cx='%1' cy='500' r='20' stroke-width='10' stroke='black'/>").arg(x);
+		expected.append(QPoint(x * 10, 5000));
+	}
+	svg += "</svg>";
+
+	QString header = TextUtils::makeSVGHeader(1000, 1000, 1000, 1000);
+	SVG2gerber gerber;
+	gerber.convert(header + svg, 2, "drill", SVG2gerber::ForDrill, QSizeF(1000, 1000));
+
+	QList<QPoint> found;
+	QRegularExpression hitFinder("^X(\\d+)Y(\\d+)$", QRegularExpression::MultilineOption);
+	QRegularExpressionMatchIterator matches = hitFinder.globalMatch(gerber.getGerber());
+	while (matches.hasNext()) {
+		QRegularExpressionMatch match = matches.next();
+		found.append(QPoint(match.captured(1).toInt(), match.captured(2).toInt()));
+	}
+
+	BOOST_CHECK(sorted(found) == sorted(expected));
+	BOOST_CHECK(gerber.drillTravelAfter() <= gerber.drillTravelBefore());
+}
@@ -31,6 +31,8 @@ SOURCES += $$files(*.cpp)
 INCLUDEPATH += $$absolute_path(../../../src)
 
 HEADERS += $$files(../../../src/debugdialog.h)
+HEADERS += $$files(../../../src/svg/drillorder.h)
+HEADERS += $$files(../../../src/svg/gerberpanel.h)
 HEADERS += $$files(../../../src/svg/svg2gerber.h)
 HEADERS += $$files(../../../src/svg/svgfilesplitter.h)
 HEADERS += $$files(../../../src/svg/svgflattener.h)
@@ -38,11 +40,14 @@ HEADERS += $$files(../../../src/svg/svgpathgrammar_p.h)
 HEADERS += $$files(../../../src/svg/svgpathlexer.h)
 HEADERS += $$files(../../../src/svg/svgpathparser.h)
 HEADERS += $$files(../../../src/svg/svgpathrunner.h)
+HEADERS += $$files(../../../src/svg/svgpathscanner.h)
 HEADERS += $$files(../../../src/svg/svgtext.h)
 HEADERS += $$files(../../../src/utils/graphicsutils.h)
 HEADERS += $$files(../../../src/utils/textutils.h)
 
 SOURCES += $$files(../../../src/debugdialog.cpp)
+SOURCES += $$files(../../../src/svg/drillorder.cpp)
+SOURCES += $$files(../../../src/svg/gerberpanel.cpp)
 SOURCES += $$files(../../../src/svg/svg2gerber.cpp)
 SOURCES += $$files(../../../src/svg/svgfilesplitter.cpp)
 SOURCES += $$files(../../../src/svg/svgflattener.cpp)
@@ -51,6 +56,7 @@ SOURCES += $$files(../../../src/svg/svgpathlexer.cpp)
 SOURCES += $$files(../../../src/svg/svgpathparser.cpp)
 SOURCES += $$files(../../../src/svg/svgpathgrammar.cpp)
 SOURCES += $$files(../../../src/svg/svgpathrunner.cpp)
+SOURCES += $$files(../../../src/svg/svgpathscanner.cpp)
 SOURCES += $$files(../../../src/utils/graphicsutils.cpp)
 SOURCES += $$files(../../../src/utils/textutils.cpp)
 #INCLUDEPATH += $$top_srcdir
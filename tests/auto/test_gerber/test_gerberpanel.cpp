@@ -0,0 +1,144 @@
+#include <boost/test/unit_test.hpp>
+
+#include "svg/gerberpanel.h"
+
+static GerberPanel makePanel(int columns, int rows, double gap, double rail)
+{
+	GerberPanel panel(columns, rows, gap, rail);
+	panel.setBoardSize(QSizeF(1, 0.5));
+	return panel;
+}
+
+static const QByteArray GerberHeader("G04 MADE WITH FRITZING*\n%FSLAX23Y23*%\n%MOIN*%\n%ADD10C,0.008000*%\n");
+static const QByteArray GerberPaths("D10*\nX0Y0D02*\nX1000Y0D01*\nG04 End of copper0*\nM02*");
+
+BOOST_AUTO_TEST_CASE( gerberpanel_single_board )
+{
+	GerberPanel panel = makePanel(1, 1, 0.1, 0);
+	BOOST_CHECK(panel.isEmpty());
+
+	QByteArray header(GerberHeader);
+	QByteArray paths(GerberPaths);
+	panel.apply(header, paths, SVG2gerber::ForCopper);
+	BOOST_CHECK(header == GerberHeader);
+	BOOST_CHECK(paths == GerberPaths);
+}
+
+BOOST_AUTO_TEST_CASE( gerberpanel_step_and_repeat )
+{
+	GerberPanel panel = makePanel(3, 2, 0.1, 0.2);
+	panel.setFiducials(true);
+
+	QByteArray header(GerberHeader);
+	QByteArray paths(GerberPaths);
+	panel.apply(header, paths, SVG2gerber::ForCopper);
+
+	// the board image is written once inside the step-and-repeat block
+	BOOST_CHECK(paths.startsWith("%SRX3Y2I1.100000J0.600000*%\n"));
+	BOOST_CHECK_EQUAL(paths.count("X1000Y0D01*"), 1);
+	BOOST_CHECK(paths.indexOf("%SR*%\n") < paths.indexOf("G04 End of"));
+	BOOST_CHECK(paths.endsWith("M02*"));
+
+	// three fiducials with their own aperture, centered on the rails
+	BOOST_CHECK(header.contains("%ADD11C,0.039370*%"));
+	BOOST_CHECK_EQUAL(paths.count("D03*"), 3);
+	BOOST_CHECK(paths.contains("X200Y-200D03*"));
+	BOOST_CHECK(paths.contains("X200Y1300D03*"));
+
+	// the mask opening is larger, and silk gets no fiducials
+	header = GerberHeader;
+	paths = GerberPaths;
+	panel.apply(header, paths, SVG2gerber::ForMask);
+	BOOST_CHECK(header.contains("%ADD11C,0.078740*%"));
+
+	header = GerberHeader;
+	paths = GerberPaths;
+	panel.apply(header, paths, SVG2gerber::ForSilk);
+	BOOST_CHECK(header == GerberHeader);
+	BOOST_CHECK_EQUAL(paths.count("D03*"), 0);
+}
+
+BOOST_AUTO_TEST_CASE( gerberpanel_outline )
+{
+	// without rails there is a tab only where two boards face each other, and no frame
+	GerberPanel panel = makePanel(2, 1, 0.1, 0);
+	BOOST_CHECK_EQUAL(panel.tabs().count(), 1);
+
+	// eight board edges, the two facing the tab broken in two, and the two sides of the tab
+	QList<QLineF> lines = panel.cutLines();
+	BOOST_CHECK_EQUAL(lines.count(), 12);
+	BOOST_CHECK(lines.contains(QLineF(1, 0, 1, 0.15)));
+	BOOST_CHECK(lines.contains(QLineF(1, 0.35, 1, 0.5)));
+	BOOST_CHECK(lines.contains(QLineF(1.1, 0, 1.1, 0.15)));
+	BOOST_CHECK(lines.contains(QLineF(1, 0.15, 1.1, 0.15)));
+	BOOST_CHECK(lines.contains(QLineF(1, 0.35, 1.1, 0.35)));
+	BOOST_CHECK(!lines.contains(QLineF(1, 0, 1, 0.5)));
+
+	// the board's own contour is replaced, and nothing relies on clear polarity
+	QByteArray header(GerberHeader);
+	QByteArray paths(GerberPaths);
+	panel.apply(header, paths, SVG2gerber::ForOutline);
+	BOOST_CHECK(header.contains("%ADD11C,0.008000*%"));
+	BOOST_CHECK(!paths.contains("D10*"));
+	BOOST_CHECK(!paths.contains("%LP"));
+	BOOST_CHECK(!paths.contains("D03*"));
+	BOOST_CHECK(paths.startsWith("G01*\nD11*\n"));
+	BOOST_CHECK_EQUAL(paths.count("D01*"), 12);
+	BOOST_CHECK(paths.contains("X1000Y0D02*\nX1000Y150D01*\n"));
+	BOOST_CHECK(paths.contains("X1000Y350D02*\nX1100Y350D01*\n"));
+	BOOST_CHECK(paths.endsWith("G04 End of copper0*\nM02*"));
+
+	// with rails every board edge facing a rail also gets a tab, the rails' inner edges are cut too, and the panel gets a frame
+	panel = makePanel(2, 2, 0.1, 0.2);
+	BOOST_CHECK_EQUAL(panel.tabs().count(), 8);
+	BOOST_CHECK(panel.panelRect() == QRectF(0, -0.3, 2.1, 1.7));
+
+	// 16 board edges and 2 rail edges, 16 breaks, 16 tab sides
+	lines = panel.cutLines();
+	BOOST_CHECK_EQUAL(lines.count(), 18 + 16 + 16);
+	BOOST_CHECK(lines.contains(QLineF(0, -0.1, 0.4, -0.1)));
+	BOOST_CHECK(lines.contains(QLineF(0.4, -0.1, 0.4, 0)));
+
+	header = GerberHeader;
+	paths = GerberPaths;
+	panel.apply(header, paths, SVG2gerber::ForOutline);
+	BOOST_CHECK_EQUAL(paths.count("D03*"), 0);
+	BOOST_CHECK_EQUAL(paths.count("D01*"), 50 + 4);
+	BOOST_CHECK(paths.contains("X0Y-300D02*"));
+}
+
+BOOST_AUTO_TEST_CASE( gerberpanel_drill )
+{
+	GerberPanel panel = makePanel(2, 2, 0.1, 0.2);
+	panel.setMouseBites(true);
+
+	QByteArray header("; NON-PLATED HOLES START AT T1\n; THROUGH (PLATED) HOLES START AT T100\nM48\nINCH\nT1C0.035000\nT100C0.040000\n%\n");
+	QByteArray paths("T1\nX001000Y002000\nX003000Y002000\nT100\nX005000Y001000\nT00\nM30\n");
+	panel.apply(header, paths, SVG2gerber::ForDrill);
+
+	// every hit is repeated per board, tool by tool
+	BOOST_CHECK(paths.contains("X001000Y002000\n"));
+	BOOST_CHECK(paths.contains("X012000Y002000\n"));
+	BOOST_CHECK(paths.contains("X001000Y008000\n"));
+	BOOST_CHECK(paths.contains("X016000Y007000\n"));
+	BOOST_CHECK(paths.indexOf("X012000Y002000") < paths.indexOf("T100\n"));
+
+	// the mouse bites use a new non-plated tool, drilled before the plated ones: 12 rows of 6 holes
+	BOOST_CHECK(header.endsWith("T1C0.035000\nT2C0.020000\nT100C0.040000\n%\n"));
+	BOOST_CHECK_EQUAL(panel.mouseBiteHoles().count(), 72);
+	int bites = paths.indexOf("T2\n");
+	int plated = paths.indexOf("T100\n");
+	BOOST_REQUIRE(bites > 0);
+	BOOST_CHECK(paths.indexOf("X012000Y002000") < bites);
+	BOOST_CHECK_EQUAL(paths.mid(bites, plated - bites).count('\n'), 1 + 72);
+	BOOST_CHECK(paths.endsWith("T00\nM30\n"));
+
+	// without plated holes the bites go last
+	header = "M48\nINCH\nT1C0.035000\n%\n";
+	paths = "T1\nX001000Y002000\nT00\nM30\n";
+	panel.apply(header, paths, SVG2gerber::ForDrill);
+	BOOST_CHECK(header.endsWith("T1C0.035000\nT2C0.020000\n%\n"));
+	bites = paths.indexOf("T2\n");
+	BOOST_REQUIRE(bites > 0);
+	BOOST_CHECK_EQUAL(paths.mid(bites).count('\n'), 1 + 72 + 2);
+}
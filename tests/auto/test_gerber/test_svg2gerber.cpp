@@ -16,6 +16,7 @@ specifcation strings, and segments
 
 #include <QFile>
 #include <QTextStream>
+#include <QBuffer>
 
 BOOST_AUTO_TEST_CASE( test_svg2gerber )
 {
@@ -43,3 +44,30 @@ BOOST_AUTO_TEST_CASE( test_svg2gerber )
 	gerber3.convert(header + svgs[0], 2, "Silk1", SVG2gerber::ForSilk, QSizeF(3333.33, 2222.22));
 	BOOST_CHECK_EQUAL(gerber3.getGerber().toStdString(), gerbers[2].toStdString());
 }
+
+BOOST_AUTO_TEST_CASE( test_svg2gerber_apertures )
+{
+	// repeated pads share one aperture; write() streams the same bytes getGerber() returns
+	QString svg = "<circle fill='black' cx='100' cy='100' r='30' stroke-width='10' stroke='black'/>"
+	              "<circle fill='black' cx='200' cy='100' r='30' stroke-width='10' stroke='black'/>"
+	              "<rect fill='black' x='300' y='80' width='40' height='40' stroke-width='0'/>"
+	              "<circle fill='black' cx='400' cy='100' r='30' stroke-width='10' stroke='black'/>"
+	              "<rect fill='black' x='500' y='80' width='40' height='40' stroke-width='0'/>"
+	              "</svg>";
+
+	QString header = TextUtils::makeSVGHeader(1000, 1000, 1000, 1000);
+	SVG2gerber gerber;
+	gerber.convert(header + svg, 2, "Copper1", SVG2gerber::ForCopper, QSizeF(1000, 1000));
+	QString output = gerber.getGerber();
+
+	BOOST_CHECK_EQUAL(output.count("%ADD"), 2);
+	BOOST_CHECK(output.contains("%ADD10C,0.070000*%\n"));
+	BOOST_CHECK(output.contains("%ADD11R,0.040000X0.040000*%\n"));
+	// circles are written before rects
+	BOOST_CHECK(output.contains("G54D10*\nX100Y900D03*\nX200Y900D03*\nX400Y900D03*\nG54D11*\nX320Y900D03*\nX520Y900D03*\n"));
+
+	QBuffer buffer;
+	buffer.open(QIODevice::WriteOnly);
+	BOOST_REQUIRE(gerber.write(buffer));
+	BOOST_CHECK_EQUAL(QString::fromUtf8(buffer.data()).toStdString(), output.toStdString());
+}
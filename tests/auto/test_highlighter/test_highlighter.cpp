@@ -0,0 +1,122 @@
+#define BOOST_TEST_MODULE Highlighter Tests
+#include <boost/test/included/unit_test.hpp>
+
+#include "program/highlighter.h"
+#include "program/syntaxer.h"
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QTextBlock>
+#include <QTextDocument>
+#include <QTextEdit>
+#include <QTextLayout>
+
+static QApplication * application()
+{
+	static int argc = 1;
+	static char name[] = "test_highlighter";
+	static char * argv[] = { name, nullptr };
+	static QApplication * app = nullptr;
+	if (app == nullptr) {
+		if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+			qputenv("QT_QPA_PLATFORM", "offscreen");
+		}
+		app = new QApplication(argc, argv);
+		Highlighter::loadStyles(QString(SYNTAX_FOLDER) + "/styles.xml");
+	}
+	return app;
+}
+
+static Syntaxer * arduinoSyntaxer()
+{
+	static Syntaxer * syntaxer = nullptr;
+	if (syntaxer == nullptr) {
+		syntaxer = new Syntaxer();
+		syntaxer->loadSyntax(QString(SYNTAX_FOLDER) + "/arduino.xml");
+	}
+	return syntaxer;
+}
+
+// foreground color applied at position pos of the given line, or an empty string
+static QString colorAt(QTextDocument * document, int line, int pos)
+{
+	QTextBlock block = document->findBlockByNumber(line);
+	Q_FOREACH (QTextLayout::FormatRange range, block.layout()->formats()) {
+		if (pos >= range.start && pos < range.start + range.length) {
+			return range.format.foreground().color().name();
+		}
+	}
+	return QString();
+}
+
+BOOST_AUTO_TEST_CASE( highlighter_tokens )
+{
+	application();
+	QTextEdit textEdit;
+	auto * highlighter = new Highlighter(&textEdit);
+	highlighter->setSyntaxer(arduinoSyntaxer());
+	textEdit.setPlainText(
+		"int led13 = 0x1F; // \"not a string\"\n"
+		"char c = '\\n'; String s = \"a\\\"b // c\"; float f = 2.5e3;\n"
+		"/* comment\n"
+		"still */ 017 12UL\n"
+		"for (;;) {}");
+	highlighter->rehighlight();
+	QTextDocument * document = textEdit.document();
+
+	const QString keyword("#f9bb4e");
+	const QString dataType("#6dba82");
+	const QString hex("#00dddd");
+	const QString number("#d77b0e");
+	const QString comment("#808080");
+	const QString constant("#77acc2");
+
+	// int is in both keyword1 and types; the later list wins
+	BOOST_CHECK_EQUAL(colorAt(document, 0, 0).toStdString(), dataType.toStdString());
+	// digits inside an identifier are not a number
+	BOOST_CHECK(colorAt(document, 0, 7).isEmpty());
+	BOOST_CHECK_EQUAL(colorAt(document, 0, 14).toStdString(), hex.toStdString());
+	// a string delimiter inside a comment does not start a string
+	BOOST_CHECK_EQUAL(colorAt(document, 0, 22).toStdString(), comment.toStdString());
+	BOOST_CHECK_EQUAL(colorAt(document, 0, 34).toStdString(), comment.toStdString());
+
+	BOOST_CHECK_EQUAL(colorAt(document, 1, 10).toStdString(), constant.toStdString());
+	// an escaped delimiter and a comment start stay inside the string
+	int stringStart = document->findBlockByNumber(1).text().indexOf('"');
+	BOOST_CHECK_EQUAL(colorAt(document, 1, stringStart + 4).toStdString(), number.toStdString());
+	BOOST_CHECK_EQUAL(colorAt(document, 1, stringStart + 7).toStdString(), number.toStdString());
+	int floatStart = document->findBlockByNumber(1).text().indexOf("2.5e3");
+	BOOST_CHECK_EQUAL(colorAt(document, 1, floatStart + 4).toStdString(), number.toStdString());
+
+	// multi-line comments carry over through the block state
+	BOOST_CHECK_EQUAL(colorAt(document, 2, 3).toStdString(), comment.toStdString());
+	BOOST_CHECK_EQUAL(colorAt(document, 3, 2).toStdString(), comment.toStdString());
+	BOOST_CHECK(colorAt(document, 3, 8).isEmpty());
+	BOOST_CHECK_EQUAL(colorAt(document, 3, 9).toStdString(), hex.toStdString());
+	BOOST_CHECK_EQUAL(colorAt(document, 3, 13).toStdString(), number.toStdString());
+	BOOST_CHECK(colorAt(document, 3, 15).isEmpty());
+
+	BOOST_CHECK_EQUAL(colorAt(document, 4, 0).toStdString(), keyword.toStdString());
+}
+
+BOOST_AUTO_TEST_CASE( highlighter_large_sketch )
+{
+	application();
+	QString sketch;
+	for (int i = 0; i < 5000; i++) {
+		sketch += QString("void function%1(int pin) { /* toggle */ digitalWrite(pin, HIGH); delay(0x%2); Serial.println(\"pin %1\"); } // %3\n")
+		          .arg(i).arg(i, 0, 16).arg(i * 0.5);
+	}
+
+	QTextEdit textEdit;
+	auto * highlighter = new Highlighter(&textEdit);
+	highlighter->setSyntaxer(arduinoSyntaxer());
+	textEdit.setPlainText(sketch);
+
+	QElapsedTimer timer;
+	timer.start();
+	highlighter->rehighlight();
+	BOOST_TEST_MESSAGE("highlighting " << textEdit.document()->blockCount() << " lines took " << timer.elapsed() << " ms");
+
+	BOOST_CHECK(!colorAt(textEdit.document(), 4999, 0).isEmpty());
+}
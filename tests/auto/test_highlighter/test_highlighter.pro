@@ -0,0 +1,47 @@
+# /*******************************************************************
+# Part of the Fritzing project - http://fritzing.org
+# Copyright (c) 2019 Fritzing
+# Fritzing is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+# Fritzing is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+# You should have received a copy of the GNU General Public License
+# along with Fritzing. If not, see <http://www.gnu.org/licenses/>.
+# ********************************************************************/
+
+CONFIG += c++17
+
+
+# specify absolute path so that unit test compiles will find the folder
+absolute_boost = 1
+include($$absolute_path(../../../pri/boostdetect.pri))
+include($$absolute_path(../../../pri/svgppdetect.pri))
+
+QT += core xml svg gui widgets
+equals(QT_MAJOR_VERSION, 6) {
+  QT += core5compat svgwidgets
+}
+
+HEADERS += $$files(*.h)
+SOURCES += $$files(*.cpp)
+
+INCLUDEPATH += $$absolute_path(../../../src)
+DEFINES += SYNTAX_FOLDER=\\\"$$absolute_path(../../../translations/syntax)\\\"
+
+HEADERS += $$files(../../../src/program/highlighter.h)
+HEADERS += $$files(../../../src/program/syntaxer.h)
+HEADERS += $$files(../../../src/program/trienode.h)
+HEADERS += $$files(../../../src/utils/textutils.h)
+HEADERS += $$files(../../../src/utils/graphicsutils.h)
+HEADERS += $$files(../../../src/debugdialog.h)
+
+SOURCES += $$files(../../../src/program/highlighter.cpp)
+SOURCES += $$files(../../../src/program/syntaxer.cpp)
+SOURCES += $$files(../../../src/program/trienode.cpp)
+SOURCES += $$files(../../../src/utils/textutils.cpp)
+SOURCES += $$files(../../../src/utils/graphicsutils.cpp)
+SOURCES += $$files(../../../src/debugdialog.cpp)
@@ -0,0 +1,162 @@
+#include "svg/svgpathparser.h"
+#include "svg/svgpathlexer.h"
+#include "svg/svgpathscanner.h"
+
+/*
+Testing that SVGPathScanner::scan accepts the same svg path element data as
+SVGPathParser::parse and produces the same commands and arguments
+*/
+
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QRegularExpression>
+
+#include <boost/test/unit_test.hpp>
+
+// flatten the scanner output into the parser's symbol stack layout
+static QVector<QVariant> toSymStack(const SVGPathData & pathData)
+{
+	QVector<QVariant> stack;
+	for (const SVGPathData::Command & command : pathData.commands) {
+		stack.append(command.command);
+		for (int i = 0; i < command.argCount; i++) {
+			stack.append(pathData.args.at(command.argStart + i));
+		}
+	}
+	return stack;
+}
+
+static bool parseWithGrammar(const QString & data, QVector<QVariant> & stack)
+{
+	QString dataCopy(data);
+	if (!dataCopy.startsWith('M', Qt::CaseInsensitive)) {
+		dataCopy.prepend('M');
+	}
+	while (dataCopy.at(dataCopy.length() - 1).isSpace()) {
+		dataCopy.remove(dataCopy.length() - 1, 1);
+	}
+	QChar last = dataCopy.at(dataCopy.length() - 1);
+	if (last != 'z' && last != 'Z' && last != SVGPathLexer::FakeClosePathChar) {
+		dataCopy.append(SVGPathLexer::FakeClosePathChar);
+	}
+
+	SVGPathLexer lexer(dataCopy);
+	SVGPathParser parser;
+	if (!parser.parse(lexer)) return false;
+
+	stack = parser.symStack();
+	return true;
+}
+
+BOOST_AUTO_TEST_CASE( pathscanner_good )
+{
+	const QStringList goodInputs = {
+		"m0,0x",
+		"m5,9.9x",
+		"m-5,-9.9x",
+		"m-4 -9.8x",
+		"m-3-9.7x",
+		"m0,0z",
+		"m1,-2a2.6,3.5,0,0,1,-5.2,0x",
+		"m2 -2a2.6 3.5 0 0 1 -5.2 0x",
+		"m3-2a2.6 3.5 0 0 1-5.2 0x",
+		"m4-2a2.6-3.5 0 0 1-5.2 0x",
+		"m-2+9.7x",
+		"m 0 , 0 x",
+		"m 0 0\nx\n",
+		"M0,0a 2.6,2.6 0 0 1 5.2,0v5.2a 2.6,2.6 0 0 1 -5.2,0z\n  m 0.5,3a 1,  1   0 0 0 4.2,0v-0.8a 1,  1   0 0 0-4.2,0z  ",
+		"M10 10 20 20 L.5.5 1e2,3E+1 C1 2 3 4 5 6 7 8 9 10 11 12 Z M1 1 h2 V3 s1 2 3 4 q1 2 3 4 t5 6",
+	};
+
+	for (int inp = 0; inp < goodInputs.size(); ++inp) {
+		QVector<QVariant> expected;
+		BOOST_REQUIRE_MESSAGE(parseWithGrammar(goodInputs.at(inp), expected), "grammar rejects input " << inp);
+
+		SVGPathData pathData;
+		BOOST_CHECK_MESSAGE(SVGPathScanner::scan(goodInputs.at(inp), pathData), "scanner rejects input " << inp);
+		BOOST_CHECK_MESSAGE(toSymStack(pathData) == expected, "scanner output differs for input " << inp);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( pathscanner_bad )
+{
+	const QStringList badInputs = {
+		"",
+		"l1,2",       // must start with a moveto
+		"m1",         // incomplete coordinate pair
+		"m1,2,",      // trailing comma
+		"m1,,2",      // double comma
+		"m1,2 l",     // command without arguments
+		"m1,2z3",     // closepath takes no arguments
+		"m1,2 a1 1 0 0 1 2", // incomplete arc
+		"m1,2 k3,4",  // unknown command
+		"m1.,2",      // the grammar does not accept a trailing decimal point
+	};
+
+	for (int inp = 0; inp < badInputs.size(); ++inp) {
+		SVGPathData pathData;
+		BOOST_CHECK_MESSAGE(!SVGPathScanner::scan(badInputs.at(inp), pathData), "scanner accepts bad input " << inp);
+		BOOST_CHECK(pathData.isEmpty());
+	}
+
+	// the regex cleanup breaks negative exponents, the scanner does not
+	SVGPathData pathData;
+	BOOST_REQUIRE(SVGPathScanner::scan(QString("m1e-2,2"), pathData));
+	BOOST_CHECK_EQUAL(pathData.args.count(), 2);
+	BOOST_CHECK_CLOSE(pathData.args.at(0), 0.01, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE( pathscanner_parts_throughput )
+{
+	static const QRegularExpression pathDataFinder(R"x(\sd\s*=\s*["']([^"']+)["'])x");
+
+	QStringList paths;
+	QDirIterator it(PARTS_SVG_FOLDER, QStringList("*.svg"), QDir::Files, QDirIterator::Subdirectories);
+	while (it.hasNext()) {
+		QFile file(it.next());
+		if (!file.open(QFile::ReadOnly)) continue;
+
+		QString svg = QString::fromUtf8(file.readAll());
+		QRegularExpressionMatchIterator matches = pathDataFinder.globalMatch(svg);
+		while (matches.hasNext()) {
+			paths.append(matches.next().captured(1));
+		}
+	}
+	BOOST_REQUIRE(!paths.isEmpty());
+
+	qint64 characters = 0;
+	QElapsedTimer timer;
+	timer.start();
+	QList<QVector<QVariant>> grammarResults;
+	for (const QString & path : paths) {
+		QVector<QVariant> stack;
+		parseWithGrammar(path, stack);
+		grammarResults.append(stack);
+		characters += path.length();
+	}
+	qint64 grammarTime = timer.nsecsElapsed();
+
+	timer.restart();
+	QList<SVGPathData> scannerResults;
+	for (const QString & path : paths) {
+		SVGPathData pathData;
+		if (path.trimmed().startsWith('M', Qt::CaseInsensitive)) {
+			SVGPathScanner::scan(path, pathData);
+		}
+		else {
+			SVGPathScanner::scan(QString('M') + path, pathData);
+		}
+		scannerResults.append(pathData);
+	}
+	qint64 scannerTime = timer.nsecsElapsed();
+
+	BOOST_TEST_MESSAGE("parsed " << paths.count() << " paths (" << characters << " characters): grammar "
+		<< grammarTime / 1000 << " us, scanner " << scannerTime / 1000 << " us");
+
+	for (int i = 0; i < paths.count(); i++) {
+		if (grammarResults.at(i).isEmpty()) continue;
+
+		BOOST_CHECK_MESSAGE(toSymStack(scannerResults.at(i)) == grammarResults.at(i), "scanner output differs for " << paths.at(i).left(80).toStdString());
+	}
+}
@@ -29,17 +29,24 @@ HEADERS += $$files(*.h)
 SOURCES += $$files(*.cpp)
 
 INCLUDEPATH += $$absolute_path(../../../src)
+DEFINES += PARTS_SVG_FOLDER=\\\"$$absolute_path(../../../resources/parts/svg)\\\"
 
 HEADERS += $$files(../../../src/svg/svgtext.h)
 HEADERS += $$files(../../../src/svg/svgpathlexer.h)
 HEADERS += $$files(../../../src/utils/textutils.h)
 HEADERS += $$files(../../../src/svg/svgpathgrammar_p.h)
 HEADERS += $$files(../../../src/svg/svgpathparser.h)
+HEADERS += $$files(../../../src/svg/svgpathscanner.h)
+HEADERS += $$files(../../../src/svg/svgfixcache.h)
+HEADERS += $$files(../../../src/svg/svgfragmentcache.h)
 
 SOURCES += $$files(../../../src/svg/svgtext.cpp)
 SOURCES += $$files(../../../src/svg/svgpathlexer.cpp)
 SOURCES += $$files(../../../src/svg/svgpathparser.cpp)
 SOURCES += $$files(../../../src/svg/svgpathgrammar.cpp)
+SOURCES += $$files(../../../src/svg/svgpathscanner.cpp)
+SOURCES += $$files(../../../src/svg/svgfixcache.cpp)
+SOURCES += $$files(../../../src/svg/svgfragmentcache.cpp)
 SOURCES += $$files(../../../src/utils/textutils.cpp)
 #INCLUDEPATH += $$top_srcdir
 # unix:QMAKE_POST_LINK = $$PWD/generated/test_svg
@@ -0,0 +1,95 @@
+#include <boost/test/unit_test.hpp>
+
+#include "svg/svgfixcache.h"
+
+#include <QDir>
+#include <QTemporaryDir>
+
+static const int Flags = SvgFixCache::FixMuch | SvgFixCache::FixPixelDimensions;
+
+BOOST_AUTO_TEST_CASE( svgfixcache_roundtrip )
+{
+	QTemporaryDir tempDir;
+	BOOST_REQUIRE(tempDir.isValid());
+	SvgFixCache::setFolder(tempDir.path());
+
+	QByteArray original("<svg width='1in' height='1in'><g/></svg>");
+	QByteArray fixed("<svg width='1in' height='1in'/>");
+	QByteArray result;
+	BOOST_CHECK(!SvgFixCache::find(original, Flags, result));
+
+	SvgFixCache::insert(original, Flags, fixed, true);
+	BOOST_REQUIRE(SvgFixCache::find(original, Flags, result));
+	BOOST_CHECK(result == fixed);
+
+	// unchanged files are stored as empty entries and come back as the original bytes
+	QByteArray clean("<svg width='2in' height='2in'/>");
+	SvgFixCache::insert(clean, Flags, clean, false);
+	BOOST_REQUIRE(SvgFixCache::find(clean, Flags, result));
+	BOOST_CHECK(result == clean);
+
+	// a single changed byte is a different entry
+	QByteArray edited(original);
+	edited.replace("1in", "3in");
+	BOOST_CHECK(!SvgFixCache::find(edited, Flags, result));
+
+	// the same bytes fixed with different options are a different entry
+	BOOST_CHECK(!SvgFixCache::find(original, Flags | SvgFixCache::FixStrokeWidth, result));
+
+	SvgFixCache::clear();
+	BOOST_CHECK(!SvgFixCache::find(original, Flags, result));
+}
+
+BOOST_AUTO_TEST_CASE( svgfixcache_eviction )
+{
+	QTemporaryDir tempDir;
+	BOOST_REQUIRE(tempDir.isValid());
+	SvgFixCache::setFolder(tempDir.path());
+	qint64 oldMaxBytes = SvgFixCache::maxBytes();
+	SvgFixCache::setMaxBytes(4000);
+
+	// explicit timestamps an hour apart, so the order does not depend on the filesystem's mtime resolution
+	QDateTime base(QDate(2020, 1, 1), QTime(0, 0), Qt::UTC);
+	QByteArray padding(500, 'x');
+	auto insertAt = [&](int i) {
+		SvgFixCache::setCurrentTime(base.addSecs(i * 60 * 60));
+		QByteArray svg = QString("<svg id='%1'/>").arg(i).toUtf8();
+		SvgFixCache::insert(svg, Flags, svg + padding, true);
+	};
+	auto found = [](int i) {
+		QByteArray result;
+		return SvgFixCache::find(QString("<svg id='%1'/>").arg(i).toUtf8(), Flags, result);
+	};
+	auto totalBytes = [&]() {
+		qint64 total = 0;
+		Q_FOREACH (QFileInfo fileInfo, QDir(tempDir.path()).entryInfoList(QDir::Files)) {
+			total += fileInfo.size();
+		}
+		return total;
+	};
+
+	for (int i = 0; i < 20; i++) {
+		insertAt(i);
+	}
+
+	// each eviction trims down to three quarters of the limit, oldest first
+	BOOST_CHECK(totalBytes() <= 3000);
+	for (int i = 0; i < 15; i++) {
+		BOOST_CHECK(!found(i));
+	}
+
+	// a hit more than a day after the last use refreshes the entry, so it outlives newer but unused ones
+	SvgFixCache::setCurrentTime(base.addSecs(100 * 60 * 60));
+	BOOST_CHECK(found(15));
+	for (int i = 20; i < 23; i++) {
+		insertAt(i);
+	}
+	BOOST_CHECK(totalBytes() <= 4000);
+	BOOST_CHECK(found(15));
+	BOOST_CHECK(!found(16));
+	BOOST_CHECK(found(19));
+	BOOST_CHECK(found(22));
+
+	SvgFixCache::setCurrentTime(QDateTime());
+	SvgFixCache::setMaxBytes(oldMaxBytes);
+}
@@ -0,0 +1,70 @@
+#include <boost/test/unit_test.hpp>
+
+#include "svg/svgfragmentcache.h"
+
+static QString fragmentKey(const QString & moduleID, double dpi)
+{
+	return SvgFragmentCache::key("/parts/svg/pcb/dip_8.svg", moduleID, ViewLayer::Copper0, ViewLayer::NewBottom,
+	                             Qt::Vertical, dpi, false, false);
+}
+
+BOOST_AUTO_TEST_CASE( svgfragmentcache_second_export_hits )
+{
+	SvgFragmentCache::clear();
+
+	QString svg;
+	double factor = 0;
+	QString key = fragmentKey("dip8", 1000);
+	BOOST_CHECK(!SvgFragmentCache::find(key, svg, factor));
+
+	// the first export normalizes the fragment and stores it
+	SvgFragmentCache::insert(key, "<g id='copper0'/>", 2.5);
+
+	// the second export of the same part builds the same key and finds it
+	BOOST_REQUIRE(SvgFragmentCache::find(fragmentKey("dip8", 1000), svg, factor));
+	BOOST_CHECK(svg == "<g id='copper0'/>");
+	BOOST_CHECK_EQUAL(factor, 2.5);
+
+	SvgFragmentCache::clear();
+}
+
+BOOST_AUTO_TEST_CASE( svgfragmentcache_changed_key_misses )
+{
+	SvgFragmentCache::clear();
+
+	QString svg;
+	double factor = 0;
+	SvgFragmentCache::insert(fragmentKey("dip8", 1000), "<g id='copper0'/>", 1);
+
+	BOOST_CHECK(!SvgFragmentCache::find(fragmentKey("dip8", 600), svg, factor));
+	BOOST_CHECK(!SvgFragmentCache::find(fragmentKey("dip14", 1000), svg, factor));
+	BOOST_CHECK(!SvgFragmentCache::find(SvgFragmentCache::key("/parts/svg/pcb/dip_8.svg", "dip8", ViewLayer::Copper1, ViewLayer::NewBottom,
+	                                                          Qt::Vertical, 1000, false, false), svg, factor));
+	BOOST_CHECK(!SvgFragmentCache::find(SvgFragmentCache::key("/parts/svg/pcb/dip_8.svg", "dip8", ViewLayer::Copper0, ViewLayer::NewBottom,
+	                                                          Qt::Vertical, 1000, true, false), svg, factor));
+	BOOST_CHECK(SvgFragmentCache::find(fragmentKey("dip8", 1000), svg, factor));
+
+	SvgFragmentCache::clear();
+}
+
+BOOST_AUTO_TEST_CASE( svgfragmentcache_invalidate_drops_one_module )
+{
+	SvgFragmentCache::clear();
+
+	QString svg;
+	double factor = 0;
+	SvgFragmentCache::insert(fragmentKey("dip8", 1000), "<g id='copper0'/>", 1);
+	SvgFragmentCache::insert(fragmentKey("dip8", 600), "<g id='copper0'/>", 1);
+	SvgFragmentCache::insert(fragmentKey("dip14", 1000), "<g id='copper0'/>", 1);
+
+	// a module id that merely starts with another one is left alone
+	SvgFragmentCache::insert(fragmentKey("dip8x", 1000), "<g id='copper0'/>", 1);
+
+	SvgFragmentCache::invalidate("dip8");
+	BOOST_CHECK(!SvgFragmentCache::find(fragmentKey("dip8", 1000), svg, factor));
+	BOOST_CHECK(!SvgFragmentCache::find(fragmentKey("dip8", 600), svg, factor));
+	BOOST_CHECK(SvgFragmentCache::find(fragmentKey("dip14", 1000), svg, factor));
+	BOOST_CHECK(SvgFragmentCache::find(fragmentKey("dip8x", 1000), svg, factor));
+
+	SvgFragmentCache::clear();
+}
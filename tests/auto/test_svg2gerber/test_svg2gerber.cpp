@@ -5,9 +5,11 @@
 #include "svg/svgfilesplitter.h"
 #include "svg/svgflattener.h"
 #include "svg/svg2gerber.h"
+#include "utils/textutils.h"
 
 #include <QTextStream>
 #include <QFile>
+#include <QElapsedTimer>
 
 /*
 Testing that svg2gerber path2gerbCommandSlot is not influenced by newlines and whitespace.
@@ -50,3 +52,33 @@ BOOST_AUTO_TEST_CASE( svg2gerber_parse )
 	}
 	BOOST_CHECK_EQUAL(pathUserData1.string.toStdString(), pathUserData2.string.toStdString());
 }
+
+BOOST_AUTO_TEST_CASE( svg2gerber_large_board )
+{
+	// a copper layer with many nested pads, traces and fills: every shape must be found exactly once
+	static constexpr int Parts = 2000;
+	QString svg;
+	for (int i = 0; i < Parts; i++) {
+		int x = 100 + (i % 50) * 60;
+		int y = 100 + (i / 50) * 60;
+		svg += QString("<g><g><circle fill='black' cx='%1' cy='%2' r='15' stroke-width='10' stroke='black'/>"
+		               "<rect fill='black' x='%3' y='%2' width='10' height='10' stroke-width='0'/></g>"
+		               "<line x1='%1' y1='%2' x2='%3' y2='%2' stroke-width='8' stroke='black'/>"
+		               "<polygon fill='black' stroke='none' points='%1,%2 %3,%2 %3,%4'/>"
+		               "<path fill='none' stroke='black' stroke-width='5' d='M%1,%2L%3,%4'/></g>")
+		       .arg(x).arg(y).arg(x + 20).arg(y + 20);
+	}
+	svg += "</svg>";
+
+	QString header = TextUtils::makeSVGHeader(1000, 1000, 3200, 2600);
+	QElapsedTimer timer;
+	timer.start();
+	SVG2gerber gerber;
+	int invalid = gerber.convert(header + svg, 2, "Copper1", SVG2gerber::ForCopper, QSizeF(3200, 2600));
+	BOOST_TEST_MESSAGE("converted " << Parts * 5 << " shapes in " << timer.elapsed() << " ms");
+
+	QString output = gerber.getGerber();
+	BOOST_CHECK_EQUAL(invalid, 0);
+	BOOST_CHECK_EQUAL(output.count("D03*"), Parts * 2);
+	BOOST_CHECK_EQUAL(output.count("G36*"), Parts);
+}
@@ -0,0 +1,20 @@
+#!/bin/bash
+# Compare the autorouter's ordering and negotiated modes on a folder of sketches.
+# Every board is routed once in each mode (the run is undone in between) and
+# one line per sketch is printed with the nets routed, jumpers and wall time of both runs,
+# followed by the router's own summary lines (vias and rounds).
+#
+# Usage: tools/routebench.sh path/to/Fritzing [FOLDER]
+# FOLDER defaults to the bundled examples in sketches/core.
+set -eu
+
+if [ -z "${1:-}" ] ; then
+  echo "Usage: $0 path/to/Fritzing [FOLDER]"
+  exit 64
+fi
+
+fritzing=$1
+folder=${2:-$(dirname "$0")/../sketches/core}
+
+QT_QPA_PLATFORM=${QT_QPA_PLATFORM:-offscreen} "$fritzing" -routebench "$folder" 2>&1 \
+  | grep -E "route benchmark|autorouter (ordering|negotiated) mode" || true